@@ -7,7 +7,10 @@
 
 #include <MaterialXCore/Util.h>
 
+#include <atomic>
+#include <exception>
 #include <mutex>
+#include <thread>
 
 namespace MaterialX
 {
@@ -31,6 +34,19 @@ template<class T> shared_ptr<T> updateChildSubclass(ElementPtr parent, ElementPt
     return newChild;
 }
 
+// The state of a parallel validation in progress on the current thread.
+struct ParallelValidation
+{
+    const Document* document;
+    unsigned int threadCount;
+    bool collectDiagnostics;
+    vector<ValidationDiagnostic> childDiagnostics;
+    size_t childMessageBegin;
+    size_t childMessageEnd;
+};
+
+thread_local ParallelValidation* activeValidation = nullptr;
+
 } // anonymous namespace
 
 //
@@ -50,73 +66,532 @@ class Document::Cache
 {
   public:
     Cache() :
-        valid(false)
+        valid(false),
+        ready(false),
+        pathIndexEnabled(false),
+        geomPathGeneration(0),
+        collectionGeneration(0),
+        geomPathIndexGeneration(0),
+        nodeDefGeneration(0),
+        signatureGeneration(0)
     {
     }
     ~Cache() { }
 
     void refresh()
     {
-        // Thread synchronization for multiple concurrent readers of a single document.
+        // Concurrent readers of an up-to-date cache return without locking.
+        if (ready.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        // Thread synchronization for multiple concurrent readers of a single
+        // document, where only the first reader performs the update.
         std::lock_guard<std::mutex> guard(mutex);
+        if (ready.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        // Apply deferred updates from copied content.
+        if (valid && !pendingElements.empty())
+        {
+            for (const weak_ptr<Element>& pending : pendingElements)
+            {
+                ElementPtr elem = pending.lock();
+                if (!elem || !isAttached(elem))
+                {
+                    continue;
+                }
+
+                // A namespace introduced by a copy changes the qualified names
+                // of all existing descendants, so a full rebuild is required.
+                if (elem->hasNamespace() && !elem->getChildren().empty())
+                {
+                    valid = false;
+                    break;
+                }
+                removeEntries(elem);
+                addEntries(elem);
+            }
+            pendingElements.clear();
+        }
+
+        // Index the new name paths of renamed elements.
+        if (valid && !pendingRenames.empty() && pathIndexEnabled)
+        {
+            for (const weak_ptr<Element>& pending : pendingRenames)
+            {
+                ElementPtr elem = pending.lock();
+                if (elem && isAttached(elem))
+                {
+                    for (ElementPtr descendant : elem->traverseTree())
+                    {
+                        addPathEntry(descendant);
+                    }
+                }
+            }
+            pendingRenames.clear();
+        }
 
         if (!valid)
         {
             // Clear the existing cache.
             portElementMap.clear();
+            downstreamPortMap.clear();
             nodeDefMap.clear();
             implementationMap.clear();
+            namePathMap.clear();
+            pendingElements.clear();
+            pendingRenames.clear();
 
             // Traverse the document to build a new cache.
+            bool indexPaths = pathIndexEnabled.load(std::memory_order_relaxed);
             for (ElementPtr elem : doc.lock()->traverseTree())
             {
-                const string& nodeName = elem->getAttribute(PortElement::NODE_NAME_ATTRIBUTE);
-                const string& nodeString = elem->getAttribute(NodeDef::NODE_ATTRIBUTE);
-                const string& nodeDefString = elem->getAttribute(InterfaceElement::NODE_DEF_ATTRIBUTE);
-
-                if (!nodeName.empty())
+                addEntries(elem);
+                if (indexPaths)
                 {
-                    PortElementPtr portElem = elem->asA<PortElement>();
-                    if (portElem)
-                    {
-                        portElementMap.insert(std::pair<string, PortElementPtr>(
-                            portElem->getQualifiedName(nodeName),
-                            portElem));
-                    }
+                    addPathEntry(elem);
                 }
-                if (!nodeString.empty())
+            }
+
+            valid = true;
+        }
+
+        // Publish the updated maps to all readers.
+        ready.store(true, std::memory_order_release);
+    }
+
+    void onAddElement(ElementPtr parent, ElementPtr elem)
+    {
+        updateGenerations(elem);
+        if (!valid || !isAttached(parent))
+        {
+            return;
+        }
+        bool indexPaths = pathIndexEnabled.load(std::memory_order_relaxed);
+        for (ElementPtr descendant : elem->traverseTree())
+        {
+            addEntries(descendant);
+            if (indexPaths)
+            {
+                addPathEntry(descendant);
+            }
+        }
+    }
+
+    void onRemoveElement(ElementPtr parent, ElementPtr elem)
+    {
+        updateGenerations(elem);
+        if (!valid || !isAttached(parent))
+        {
+            return;
+        }
+        bool indexPaths = pathIndexEnabled.load(std::memory_order_relaxed);
+        for (ElementPtr descendant : elem->traverseTree())
+        {
+            removeEntries(descendant);
+            if (indexPaths)
+            {
+                removePathEntry(descendant);
+            }
+        }
+    }
+
+    void onSetAttribute(ElementPtr elem, const string& attrib, const string& value)
+    {
+        updateGenerations(elem, attrib);
+        if (valid && attrib == Element::NAME_ATTRIBUTE)
+        {
+            onRename(elem, value);
+            return;
+        }
+        if (!valid || !isCachedAttribute(attrib))
+        {
+            return;
+        }
+        const string& prevValue = elem->getAttribute(attrib);
+        if (prevValue == value && elem->hasAttribute(attrib))
+        {
+            return;
+        }
+        if (attrib == Element::NAMESPACE_ATTRIBUTE)
+        {
+            invalidate();
+            return;
+        }
+        if (isAttached(elem))
+        {
+            removeEntry(elem, attrib, prevValue);
+            addEntry(elem, attrib, value);
+        }
+    }
+
+    void onRemoveAttribute(ElementPtr elem, const string& attrib)
+    {
+        updateGenerations(elem, attrib);
+        if (!valid || !isCachedAttribute(attrib) || !elem->hasAttribute(attrib))
+        {
+            return;
+        }
+        if (attrib == Element::NAMESPACE_ATTRIBUTE)
+        {
+            invalidate();
+            return;
+        }
+        if (isAttached(elem))
+        {
+            removeEntry(elem, attrib, elem->getAttribute(attrib));
+        }
+    }
+
+    void onCopyContent(ElementPtr elem)
+    {
+        updateGenerations(elem, EMPTY_STRING);
+        if (!valid || !isAttached(elem))
+        {
+            return;
+        }
+        if (elem->hasNamespace() && !elem->getChildren().empty())
+        {
+            invalidate();
+            return;
+        }
+
+        // Copied attributes are assigned without further notification, so
+        // the new entries for this element are added on the next refresh.
+        removeEntries(elem);
+        pendingElements.push_back(elem);
+        ready.store(false, std::memory_order_release);
+    }
+
+    void onClearContent(ElementPtr elem)
+    {
+        updateGenerations(elem, EMPTY_STRING);
+        if (!valid || !isAttached(elem))
+        {
+            return;
+        }
+        if (elem->hasNamespace() && !elem->getChildren().empty())
+        {
+            invalidate();
+            return;
+        }
+        removeEntries(elem);
+    }
+
+    void onRename(ElementPtr elem, const string& name)
+    {
+        if (!pathIndexEnabled.load(std::memory_order_relaxed) ||
+            name == elem->getName() || !isAttached(elem))
+        {
+            return;
+        }
+
+        // The rename has not yet been applied, so existing paths are removed
+        // now, and the new paths are indexed on the next refresh.
+        for (ElementPtr descendant : elem->traverseTree())
+        {
+            removePathEntry(descendant);
+        }
+        pendingRenames.push_back(elem);
+        ready.store(false, std::memory_order_release);
+    }
+
+    // Begin maintaining the name path index, which is only built once it is
+    // first queried.
+    void enablePathIndex()
+    {
+        if (pathIndexEnabled.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> guard(mutex);
+        if (pathIndexEnabled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        // An invalid cache will index paths in its next rebuild.
+        if (valid)
+        {
+            for (ElementPtr elem : doc.lock()->traverseTree())
+            {
+                addPathEntry(elem);
+            }
+        }
+        pathIndexEnabled.store(true, std::memory_order_release);
+    }
+
+    // Return the element indexed at the given name path, if any.
+    ElementPtr findPathEntry(const string& namePath) const
+    {
+        auto it = namePathMap.find(&namePath);
+        return it != namePathMap.end() ? it->second->getSelf() : ElementPtr();
+    }
+
+    // Discard the cache contents, requiring a full rebuild on the next refresh.
+    void invalidate()
+    {
+        valid = false;
+        ready.store(false, std::memory_order_release);
+        nodeDefGeneration++;
+        geomPathGeneration++;
+        collectionGeneration++;
+    }
+
+    // Advance the generations of the derived caches that may be affected by
+    // an edit to the given element.  The element's top-level ancestor is
+    // found once, and classified by category alone.
+    void updateGenerations(ElementPtr elem, const string& attrib = Element::NAME_ATTRIBUTE)
+    {
+        const string& category = getTopLevelElement(elem)->getCategory();
+        if (category == Document::CATEGORY)
+        {
+            nodeDefGeneration++;
+            geomPathGeneration++;
+            collectionGeneration++;
+            return;
+        }
+        if (category == NodeDef::CATEGORY)
+        {
+            nodeDefGeneration++;
+        }
+        else if (category == Look::CATEGORY ||
+                 category == GeomInfo::CATEGORY ||
+                 category == Collection::CATEGORY)
+        {
+            geomPathGeneration++;
+        }
+        if (elem->getCategory() == Collection::CATEGORY && attrib == Element::NAME_ATTRIBUTE)
+        {
+            collectionGeneration++;
+        }
+    }
+
+  private:
+    // Return the ancestor of the given element that is a direct child of the
+    // document, or the document itself.
+    static ElementPtr getTopLevelElement(ElementPtr elem)
+    {
+        for (ElementPtr parent = elem->getParent(); parent; )
+        {
+            ElementPtr grandparent = parent->getParent();
+            if (!grandparent)
+            {
+                break;
+            }
+            elem = parent;
+            parent = grandparent;
+        }
+        return elem;
+    }
+
+    // Return true if the given attribute contributes to the keys of the cache.
+    static bool isCachedAttribute(const string& attrib)
+    {
+        return attrib == PortElement::NODE_NAME_ATTRIBUTE ||
+               attrib == NodeDef::NODE_ATTRIBUTE ||
+               attrib == InterfaceElement::NODE_DEF_ATTRIBUTE ||
+               attrib == Element::NAMESPACE_ATTRIBUTE;
+    }
+
+    // Return true if the given element is reachable from the document root.
+    bool isAttached(ConstElementPtr elem) const
+    {
+        for (ConstElementPtr parent = elem->getParent(); parent; parent = elem->getParent())
+        {
+            if (parent->getChild(elem->getName()) != elem)
+            {
+                return false;
+            }
+            elem = parent;
+        }
+        return elem == doc.lock();
+    }
+
+    void addEntries(ElementPtr elem)
+    {
+        addEntry(elem, PortElement::NODE_NAME_ATTRIBUTE, elem->getAttribute(PortElement::NODE_NAME_ATTRIBUTE));
+        addEntry(elem, NodeDef::NODE_ATTRIBUTE, elem->getAttribute(NodeDef::NODE_ATTRIBUTE));
+        addEntry(elem, InterfaceElement::NODE_DEF_ATTRIBUTE, elem->getAttribute(InterfaceElement::NODE_DEF_ATTRIBUTE));
+    }
+
+    void removeEntries(ElementPtr elem)
+    {
+        removeEntry(elem, PortElement::NODE_NAME_ATTRIBUTE, elem->getAttribute(PortElement::NODE_NAME_ATTRIBUTE));
+        removeEntry(elem, NodeDef::NODE_ATTRIBUTE, elem->getAttribute(NodeDef::NODE_ATTRIBUTE));
+        removeEntry(elem, InterfaceElement::NODE_DEF_ATTRIBUTE, elem->getAttribute(InterfaceElement::NODE_DEF_ATTRIBUTE));
+    }
+
+    void addEntry(ElementPtr elem, const string& attrib, const string& value)
+    {
+        if (value.empty())
+        {
+            return;
+        }
+        if (attrib == PortElement::NODE_NAME_ATTRIBUTE)
+        {
+            PortElementPtr portElem = elem->asA<PortElement>();
+            if (portElem)
+            {
+                portElementMap.insert(std::pair<string, PortElementPtr>(
+                    portElem->getQualifiedName(value),
+                    portElem));
+                ConstGraphElementPtr graph = portElem->getAncestorOfType<GraphElement>();
+                if (graph)
                 {
-                    NodeDefPtr nodeDef = elem->asA<NodeDef>();
-                    if (nodeDef)
-                    {
-                        nodeDefMap.insert(std::pair<string, NodeDefPtr>(
-                            nodeDef->getQualifiedName(nodeString),
-                            nodeDef));
-                    }
+                    downstreamPortMap[graph.get()].insert(std::pair<string, PortElementPtr>(
+                        value,
+                        portElem));
                 }
-                if (!nodeDefString.empty())
+            }
+        }
+        else if (attrib == NodeDef::NODE_ATTRIBUTE)
+        {
+            NodeDefPtr nodeDef = elem->asA<NodeDef>();
+            if (nodeDef)
+            {
+                nodeDefMap.insert(std::pair<string, NodeDefPtr>(
+                    nodeDef->getQualifiedName(value),
+                    nodeDef));
+            }
+        }
+        else if (attrib == InterfaceElement::NODE_DEF_ATTRIBUTE)
+        {
+            InterfaceElementPtr interface = elem->asA<InterfaceElement>();
+            if (interface && (interface->isA<Implementation>() || interface->isA<NodeGraph>()))
+            {
+                implementationMap.insert(std::pair<string, InterfaceElementPtr>(
+                    interface->getQualifiedName(value),
+                    interface));
+            }
+        }
+    }
+
+    void removeEntry(ElementPtr elem, const string& attrib, const string& value)
+    {
+        if (value.empty())
+        {
+            return;
+        }
+        if (attrib == PortElement::NODE_NAME_ATTRIBUTE)
+        {
+            eraseMapEntry(portElementMap, elem->getQualifiedName(value), elem);
+            ConstGraphElementPtr graph = elem->getAncestorOfType<GraphElement>();
+            auto it = graph ? downstreamPortMap.find(graph.get()) : downstreamPortMap.end();
+            if (it != downstreamPortMap.end())
+            {
+                eraseMapEntry(it->second, value, elem);
+                if (it->second.empty())
                 {
-                    InterfaceElementPtr interface = elem->asA<InterfaceElement>();
-                    if (interface && (interface->isA<Implementation>() || interface->isA<NodeGraph>()))
-                    {
-                        implementationMap.insert(std::pair<string, InterfaceElementPtr>(
-                            interface->getQualifiedName(nodeDefString),
-                            interface));
-                    }
+                    downstreamPortMap.erase(it);
                 }
             }
+        }
+        else if (attrib == NodeDef::NODE_ATTRIBUTE)
+        {
+            eraseMapEntry(nodeDefMap, elem->getQualifiedName(value), elem);
+        }
+        else if (attrib == InterfaceElement::NODE_DEF_ATTRIBUTE)
+        {
+            eraseMapEntry(implementationMap, elem->getQualifiedName(value), elem);
+        }
+    }
 
-            valid = true;
+    // Path entries are keyed by the cached name path of each element, which
+    // remains unchanged until the element is renamed or removed, at which
+    // point its entry is removed.
+    void addPathEntry(ElementPtr elem)
+    {
+        const string& namePath = elem->getCachedNamePath();
+        if (namePath.empty())
+        {
+            return;
+        }
+        auto result = namePathMap.emplace(&namePath, elem.get());
+        if (!result.second)
+        {
+            namePathMap.erase(result.first);
+            namePathMap.emplace(&namePath, elem.get());
+        }
+    }
+
+    void removePathEntry(ElementPtr elem)
+    {
+        auto it = namePathMap.find(&elem->getCachedNamePath());
+        if (it != namePathMap.end() && it->second == elem.get())
+        {
+            namePathMap.erase(it);
+        }
+    }
+
+    struct NamePathHash
+    {
+        size_t operator()(const string* namePath) const
+        {
+            return std::hash<string>()(*namePath);
+        }
+    };
+
+    struct NamePathEqual
+    {
+        bool operator()(const string* lhs, const string* rhs) const
+        {
+            return *lhs == *rhs;
+        }
+    };
+
+    template <class T> static void eraseMapEntry(std::unordered_multimap<string, shared_ptr<T>>& map,
+                                                 const string& key, ElementPtr elem)
+    {
+        auto keyRange = map.equal_range(key);
+        for (auto it = keyRange.first; it != keyRange.second; ++it)
+        {
+            if (it->second == elem)
+            {
+                map.erase(it);
+                return;
+            }
         }
     }
 
   public:
+    // Edits to the document update the maps in place, and are not expected
+    // to run concurrently with readers.  Readers may run concurrently with
+    // one another, and only synchronize when a refresh is required.
     weak_ptr<Document> doc;
     std::mutex mutex;
     bool valid;
+    std::atomic<bool> ready;
     std::unordered_multimap<string, PortElementPtr> portElementMap;
+    std::unordered_map<const Element*, std::unordered_multimap<string, PortElementPtr>> downstreamPortMap;
     std::unordered_multimap<string, NodeDefPtr> nodeDefMap;
     std::unordered_multimap<string, InterfaceElementPtr> implementationMap;
+    std::atomic<bool> pathIndexEnabled;
+    std::unordered_map<const string*, Element*, NamePathHash, NamePathEqual> namePathMap;
+    vector<weak_ptr<Element>> pendingElements;
+    vector<weak_ptr<Element>> pendingRenames;
+
+    // The geometry path index is maintained separately, and is rebuilt when
+    // the geometry path generation advances.
+    std::atomic<size_t> geomPathGeneration;
+
+    // Compiled collection matchers are rebuilt when the collection
+    // generation advances.
+    std::atomic<size_t> collectionGeneration;
+    std::mutex geomPathIndexMutex;
+    ConstGeomPathIndexPtr geomPathIndex;
+    size_t geomPathIndexGeneration;
+
+    // The nodedefs resolved for each node signature, which are discarded when
+    // the nodedef generation advances.
+    std::atomic<size_t> nodeDefGeneration;
+    std::mutex signatureMutex;
+    std::unordered_map<string, NodeDefPtr> signatureMap;
+    size_t signatureGeneration;
 };
 
 //
@@ -125,7 +600,8 @@ class Document::Cache
 
 Document::Document(ElementPtr parent, const string& name) :
     GraphElement(parent, CATEGORY, name),
-    _cache(std::unique_ptr<Cache>(new Cache))
+    _cache(std::unique_ptr<Cache>(new Cache)),
+    _bulkLoadDepth(0)
 {
 }
 
@@ -135,9 +611,8 @@ Document::~Document()
 
 void Document::initialize()
 {
-    _root = getSelf();
-
-    DocumentPtr doc = getDocument();
+    DocumentPtr doc = std::static_pointer_cast<Document>(getSelf());
+    _document = doc;
     _cache->doc = doc;
 
     clearContent();
@@ -180,6 +655,52 @@ void Document::importLibrary(ConstDocumentPtr library, const CopyOptions* copyOp
     }
 }
 
+void Document::setElementArenaEnabled(bool enable)
+{
+    if (!enable)
+    {
+        _elementArena = nullptr;
+    }
+    else if (!_elementArena)
+    {
+        _elementArena = std::make_shared<ElementArena>();
+    }
+}
+
+void Document::beginBulkLoad()
+{
+    // Cached lookups are not maintained during the bulk load, so existing
+    // cache contents are discarded when the outermost bulk load begins.
+    if (_bulkLoadDepth++ == 0)
+    {
+        _cache->invalidate();
+    }
+}
+
+void Document::invalidateCache()
+{
+    _cache->invalidate();
+}
+
+void Document::endBulkLoad()
+{
+    if (_bulkLoadDepth == 0)
+    {
+        throw Exception("Unbalanced call to endBulkLoad");
+    }
+    if (--_bulkLoadDepth > 0)
+    {
+        return;
+    }
+
+    // Changes made during the bulk load were not tracked incrementally, so
+    // the cache is rebuilt in a single pass on its next use.
+    _cache->invalidate();
+
+    ScopedUpdate update(getDocument());
+    onBulkLoad();
+}
+
 std::pair<int, int> Document::getVersionIntegers() const
 {
     if (!hasVersionString())
@@ -206,6 +727,35 @@ vector<PortElementPtr> Document::getMatchingPorts(const string& nodeName) const
     return ports;
 }
 
+vector<PortElementPtr> Document::getDownstreamPorts(const Node& node) const
+{
+    // Refresh the cache.
+    _cache->refresh();
+
+    // Ports connect to the node by name within the scope of its parent graph.
+    vector<PortElementPtr> ports;
+    ConstElementPtr graph = node.getParent();
+    auto graphIt = graph ? _cache->downstreamPortMap.find(graph.get()) : _cache->downstreamPortMap.end();
+    if (graphIt == _cache->downstreamPortMap.end())
+    {
+        return ports;
+    }
+    auto keyRange = graphIt->second.equal_range(node.getName());
+    for (auto it = keyRange.first; it != keyRange.second; ++it)
+    {
+        ports.push_back(it->second);
+    }
+    return ports;
+}
+
+ElementPtr Document::getIndexedElement(const string& namePath) const
+{
+    // Refresh the cache, indexing name paths on first use.
+    _cache->enablePathIndex();
+    _cache->refresh();
+    return _cache->findPathEntry(namePath);
+}
+
 ValuePtr Document::getGeomAttrValue(const string& geomAttrName, const string& geom) const
 {
     ValuePtr value;
@@ -224,6 +774,114 @@ ValuePtr Document::getGeomAttrValue(const string& geomAttrName, const string& ge
     return value;
 }
 
+NodeDefPtr Document::getSignatureNodeDef(const Node& node, const string& target) const
+{
+    // Gather the candidate nodedefs, in order of precedence.
+    string qualifiedCategory = node.getQualifiedName(node.getCategory());
+    auto findNodeDef = [this, &node, &target, &qualifiedCategory]()
+    {
+        vector<NodeDefPtr> nodeDefs = getMatchingNodeDefs(qualifiedCategory);
+        vector<NodeDefPtr> secondary = getMatchingNodeDefs(node.getCategory());
+        nodeDefs.insert(nodeDefs.end(), secondary.begin(), secondary.end());
+        for (NodeDefPtr nodeDef : nodeDefs)
+        {
+            if (targetStringsMatch(nodeDef->getTarget(), target) &&
+                nodeDef->isVersionCompatible(node.getSelf()) &&
+                node.isTypeCompatible(nodeDef))
+            {
+                return nodeDef;
+            }
+        }
+        return NodeDefPtr();
+    };
+
+    // The signature of a node captures each of its properties that is
+    // considered in nodedef matching, with value elements sorted by name.
+    StringVec ports;
+    for (ValueElementPtr value : node.getActiveValueElements())
+    {
+        ports.push_back(value->getName() + " " + value->getCategory() + " " + value->getType());
+    }
+    std::sort(ports.begin(), ports.end());
+    string signature = qualifiedCategory + "\n" + node.getCategory() + "\n" + node.getType() + "\n" + target;
+    signature += node.hasVersionString() ? "\n" + node.getVersionString() : "\n-";
+    for (const string& port : ports)
+    {
+        signature += "\n" + port;
+    }
+
+    size_t generation = _cache->nodeDefGeneration.load();
+    {
+        std::lock_guard<std::mutex> guard(_cache->signatureMutex);
+        if (_cache->signatureGeneration != generation)
+        {
+            _cache->signatureMap.clear();
+            _cache->signatureGeneration = generation;
+        }
+        auto it = _cache->signatureMap.find(signature);
+        if (it != _cache->signatureMap.end())
+        {
+            return it->second;
+        }
+    }
+
+    NodeDefPtr nodeDef = findNodeDef();
+    std::lock_guard<std::mutex> guard(_cache->signatureMutex);
+    if (_cache->signatureGeneration == generation)
+    {
+        _cache->signatureMap[signature] = nodeDef;
+    }
+    return nodeDef;
+}
+
+size_t Document::getNodeDefGeneration() const
+{
+    return _cache->nodeDefGeneration.load();
+}
+
+size_t Document::getCollectionGeneration() const
+{
+    return _cache->collectionGeneration.load();
+}
+
+ConstGeomPathIndexPtr Document::getGeomPathIndex() const
+{
+    // The cached index remains valid until a look, geominfo or collection is
+    // edited, or any edit is made during a bulk load.
+    size_t generation = _cache->geomPathGeneration.load();
+    std::lock_guard<std::mutex> guard(_cache->geomPathIndexMutex);
+    if (_cache->geomPathIndex && _cache->geomPathIndexGeneration == generation)
+    {
+        return _cache->geomPathIndex;
+    }
+
+    GeomPathIndexPtr index = std::make_shared<GeomPathIndex>();
+    for (const ElementPtr& source : getChildren())
+    {
+        if (!source->isA<Look>() && !source->isA<GeomInfo>())
+        {
+            continue;
+        }
+        vector<ElementPtr> elems = source->isA<Look>() ? source->getChildren() : vector<ElementPtr>{ source };
+        for (const ElementPtr& elem : elems)
+        {
+            GeomElementPtr geomElem = elem->asA<GeomElement>();
+            PropertyAssignPtr propertyAssign = elem->asA<PropertyAssign>();
+            if (geomElem)
+            {
+                index->addElement(elem, geomElem->getActiveGeom(), geomElem->getCollection());
+            }
+            else if (propertyAssign)
+            {
+                index->addElement(elem, propertyAssign->getGeom(), propertyAssign->getCollection());
+            }
+        }
+    }
+    _cache->geomPathIndex = index;
+    _cache->geomPathIndexGeneration = generation;
+    return index;
+}
+
 vector<NodeDefPtr> Document::getMatchingNodeDefs(const string& nodeName) const
 {
     // Refresh the cache.
@@ -265,6 +923,117 @@ bool Document::validate(string* message) const
     return GraphElement::validate(message) && res;
 }
 
+bool Document::validateParallel(string* message, unsigned int threadCount, vector<ValidationDiagnostic>* diagnostics) const
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    // Document-level checks run on the calling thread through the serial
+    // path, with validateChildren distributing the top-level elements.
+    ParallelValidation validation = { this, threadCount, diagnostics != nullptr, { }, 0, 0 };
+    ParallelValidation* prevValidation = activeValidation;
+    activeValidation = &validation;
+    string localMessage;
+    string* docMessage = (message || diagnostics) ? &localMessage : nullptr;
+    bool res;
+    try
+    {
+        res = validate(docMessage);
+    }
+    catch (...)
+    {
+        activeValidation = prevValidation;
+        throw;
+    }
+    activeValidation = prevValidation;
+
+    if (message)
+    {
+        *message += localMessage;
+    }
+    if (diagnostics)
+    {
+        // Errors reported outside of the top-level elements are attributed
+        // to the document itself.
+        string ownMessage = localMessage.substr(0, validation.childMessageBegin) +
+                            localMessage.substr(validation.childMessageEnd);
+        if (!ownMessage.empty())
+        {
+            diagnostics->emplace_back(getSelf(), ownMessage);
+        }
+        diagnostics->insert(diagnostics->end(),
+                            validation.childDiagnostics.begin(),
+                            validation.childDiagnostics.end());
+    }
+    return res;
+}
+
+bool Document::validateChildren(string* message) const
+{
+    ParallelValidation* validation = activeValidation;
+    if (!validation || validation->document != this)
+    {
+        return GraphElement::validateChildren(message);
+    }
+
+    // Claim top-level elements one at a time, so that large node graphs
+    // do not leave the remaining threads idle.
+    const vector<ElementPtr>& children = getChildren();
+    vector<string> childMessages(children.size());
+    vector<char> childResults(children.size(), true);
+    vector<std::exception_ptr> childExceptions(children.size());
+    std::atomic<size_t> nextChild(0);
+    auto worker = [&]()
+    {
+        for (size_t i = nextChild++; i < children.size(); i = nextChild++)
+        {
+            try
+            {
+                childResults[i] = children[i]->validate(message ? &childMessages[i] : nullptr);
+            }
+            catch (...)
+            {
+                childExceptions[i] = std::current_exception();
+            }
+        }
+    };
+    size_t threadCount = std::min((size_t) validation->threadCount, children.size());
+    vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Merge results in document order, matching the serial path.
+    bool res = true;
+    validation->childMessageBegin = message ? message->size() : 0;
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        if (childExceptions[i])
+        {
+            std::rethrow_exception(childExceptions[i]);
+        }
+        res = childResults[i] && res;
+        if (message)
+        {
+            *message += childMessages[i];
+        }
+        if (validation->collectDiagnostics && !childResults[i])
+        {
+            validation->childDiagnostics.emplace_back(children[i], childMessages[i]);
+        }
+    }
+    validation->childMessageEnd = message ? message->size() : 0;
+    return res;
+}
+
 void Document::upgradeVersion()
 {
     std::pair<int, int> versions = getVersionIntegers();
@@ -585,34 +1354,34 @@ void Document::upgradeVersion()
     }
 }
 
-void Document::onAddElement(ElementPtr, ElementPtr)
+void Document::onAddElement(ElementPtr parent, ElementPtr elem)
 {
-    _cache->valid = false;
+    _cache->onAddElement(parent, elem);
 }
 
-void Document::onRemoveElement(ElementPtr, ElementPtr)
+void Document::onRemoveElement(ElementPtr parent, ElementPtr elem)
 {
-    _cache->valid = false;
+    _cache->onRemoveElement(parent, elem);
 }
 
-void Document::onSetAttribute(ElementPtr, const string&, const string&)
+void Document::onSetAttribute(ElementPtr elem, const string& attrib, const string& value)
 {
-    _cache->valid = false;
+    _cache->onSetAttribute(elem, attrib, value);
 }
 
-void Document::onRemoveAttribute(ElementPtr, const string&)
+void Document::onRemoveAttribute(ElementPtr elem, const string& attrib)
 {
-    _cache->valid = false;
+    _cache->onRemoveAttribute(elem, attrib);
 }
 
-void Document::onCopyContent(ElementPtr)
+void Document::onCopyContent(ElementPtr elem)
 {
-    _cache->valid = false;
+    _cache->onCopyContent(elem);
 }
 
-void Document::onClearContent(ElementPtr)
+void Document::onClearContent(ElementPtr elem)
 {
-    _cache->valid = false;
+    _cache->onClearContent(elem);
 }
 
 } // namespace MaterialX
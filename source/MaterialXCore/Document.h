@@ -20,6 +20,7 @@ namespace MaterialX
 {
 
 class Document;
+class ValidationDiagnostic;
 
 /// A shared pointer to a Document
 using DocumentPtr = shared_ptr<Document>;
@@ -52,6 +53,7 @@ class Document : public GraphElement
     virtual DocumentPtr copy() const
     {
         DocumentPtr doc = createDocument<Document>();
+        doc->setElementArenaEnabled(getElementArena() != nullptr);
         doc->copyContentFrom(getSelf());
         return doc;
     }
@@ -65,6 +67,48 @@ class Document : public GraphElement
     ///    import function.  Defaults to a null pointer.
     void importLibrary(ConstDocumentPtr library, const CopyOptions* copyOptions = nullptr);
 
+    /// @}
+    /// @name Element Arena
+    /// @{
+
+    /// Set whether elements subsequently added to this document are allocated
+    /// from a shared memory arena.  Arena allocation places elements
+    /// contiguously in large blocks, which are released in bulk once the
+    /// document and all of its elements have been destroyed.  Memory for
+    /// elements removed from the document is not reclaimed until then, so
+    /// arena allocation is best suited to large documents that are loaded
+    /// once and edited sparingly.  Defaults to false.
+    void setElementArenaEnabled(bool enable);
+
+    /// Return the memory arena, if any, from which new elements in this
+    /// document are allocated.
+    ElementArenaPtr getElementArena() const override
+    {
+        return _elementArena;
+    }
+
+    /// @}
+    /// @name Bulk Loading
+    /// @{
+
+    /// Begin a bulk load of elements into this document.  While a bulk load
+    /// is in progress, per-element change notifications and incremental
+    /// cache maintenance are skipped, and each edit instead marks cached
+    /// lookups as stale, to be rebuilt on the next query.  Calls may be
+    /// nested, and each call must be balanced by a call to endBulkLoad.
+    void beginBulkLoad();
+
+    /// End a bulk load of elements into this document.  When the outermost
+    /// bulk load ends, document caches are invalidated and Document::onBulkLoad
+    /// is called once to report the loaded content.
+    void endBulkLoad();
+
+    /// Return true if a bulk load is in progress.
+    bool isBulkLoading() const
+    {
+        return _bulkLoadDepth > 0;
+    }
+
     /// @}
     /// @name NodeGraph Elements
     /// @{
@@ -172,6 +216,18 @@ class Document : public GraphElement
     /// Return the value of a geometric attribute for the given geometry string.
     ValuePtr getGeomAttrValue(const string& geomAttrName, const string& geom = UNIVERSAL_GEOM_NAME) const;
 
+    /// @}
+    /// @name Geometry Path Index
+    /// @{
+
+    /// Return a compiled index of the geometry strings of all GeomInfo
+    /// elements in the document, and of all MaterialAssign, PropertyAssign,
+    /// PropertySetAssign and Visibility elements within its looks.
+    ///
+    /// The index is cached, and is rebuilt on the next call after any look,
+    /// geominfo or collection in the document has been modified.
+    ConstGeomPathIndexPtr getGeomPathIndex() const;
+
     /// @}
     /// @name GeomPropDef Elements
     /// @{
@@ -513,6 +569,22 @@ class Document : public GraphElement
     /// @return True if the document passes all tests, false otherwise.
     bool validate(string* message = nullptr) const override;
 
+    /// Validate that the given document is consistent with the MaterialX
+    /// specification, distributing the top-level elements of the document
+    /// across the given number of threads.  Diagnostics are merged in
+    /// document order, so the results match those of validate().
+    /// @param message An optional output string, to which a description of
+    ///    each error will be appended.
+    /// @param threadCount The number of threads across which validation may
+    ///    be distributed, where zero selects the hardware concurrency.
+    /// @param diagnostics An optional output vector, to which a diagnostic
+    ///    will be appended for the document itself and for each top-level
+    ///    element that fails validation.
+    /// @return True if the document passes all tests, false otherwise.
+    bool validateParallel(string* message = nullptr,
+                          unsigned int threadCount = 0,
+                          vector<ValidationDiagnostic>* diagnostics = nullptr) const;
+
     /// @}
     /// @name Callbacks
     /// @{
@@ -541,6 +613,10 @@ class Document : public GraphElement
     /// Called when data is written from the current document.
     virtual void onWrite() { }
 
+    /// Called when a bulk load of elements into the current document
+    /// has completed.
+    virtual void onBulkLoad() { }
+
     /// Called before a set of document updates is performed.
     virtual void onBeginUpdate() { }
 
@@ -560,31 +636,101 @@ class Document : public GraphElement
     static const string CMS_ATTRIBUTE;
     static const string CMS_CONFIG_ATTRIBUTE;
 
+  private:
+    friend class Element;
+    friend class Node;
+    friend class Collection;
+
+    // Mark all cached lookups as stale, following an edit for which change
+    // notifications were skipped during a bulk load.
+    void invalidateCache();
+
+    // Return all port elements connected to the given node, from the cached
+    // index of connections within each graph.
+    vector<PortElementPtr> getDownstreamPorts(const Node& node) const;
+
+    // Return the element at the given name path from the cached name path
+    // index, or an empty shared pointer if no element is indexed at the path.
+    ElementPtr getIndexedElement(const string& namePath) const;
+
+    // Return the first nodedef that declares the given node for the given
+    // target, from a cached index of nodes keyed by their signatures.
+    NodeDefPtr getSignatureNodeDef(const Node& node, const string& target) const;
+
+    // Return a counter that is advanced whenever a nodedef in the document
+    // may have changed.
+    size_t getNodeDefGeneration() const;
+
+    // Return a counter that is advanced whenever a collection may have been
+    // added, removed or renamed, or an attribute of the document has changed.
+    size_t getCollectionGeneration() const;
+
+    // Validate the top-level elements of the document, distributing them
+    // across threads when called from validateParallel.
+    bool validateChildren(string* message) const override;
+
   private:
     class Cache;
     std::unique_ptr<Cache> _cache;
+    ElementArenaPtr _elementArena;
+    int _bulkLoadDepth;
+};
+
+/// @class ValidationDiagnostic
+/// The validation errors reported for a single element of a document.
+class ValidationDiagnostic
+{
+  public:
+    ValidationDiagnostic(ConstElementPtr elem, const string& msg) :
+        element(elem),
+        message(msg)
+    {
+    }
+    ~ValidationDiagnostic() { }
+
+    /// The element for which errors were reported.
+    ConstElementPtr element;
+
+    /// A description of each error reported for the element and its
+    /// descendants, in the format of Element::validate.
+    string message;
 };
 
 /// @class ScopedUpdate
 /// An RAII class for Document updates.
 ///
 /// A ScopedUpdate instance calls Document::onBeginUpdate when created, and
-/// Document::onEndUpdate when destroyed.
+/// Document::onEndUpdate when destroyed.  Both calls are skipped if the
+/// document is bulk loading when the ScopedUpdate is created.
 class ScopedUpdate
 {
   public:
     explicit ScopedUpdate(DocumentPtr doc) :
-        _doc(doc)
+        _doc(std::move(doc)),
+        _active(!_doc->isBulkLoading())
     {
-        _doc->onBeginUpdate();
+        if (_active)
+        {
+            _doc->onBeginUpdate();
+        }
     }
     ~ScopedUpdate()
     {
-        _doc->onEndUpdate();
+        if (_active)
+        {
+            _doc->onEndUpdate();
+        }
+    }
+
+    /// Return true if change notifications are being sent for this update.
+    bool isActive() const
+    {
+        return _active;
     }
 
   private:
     DocumentPtr _doc;
+    bool _active;
 };
 
 /// @class ScopedDisableCallbacks
@@ -609,6 +755,28 @@ class ScopedDisableCallbacks
     DocumentPtr _doc;
 };
 
+/// @class ScopedBulkLoad
+/// An RAII class for bulk loading elements into a Document.
+///
+/// A ScopedBulkLoad instance calls Document::beginBulkLoad when created, and
+/// Document::endBulkLoad when destroyed.
+class ScopedBulkLoad
+{
+  public:
+    explicit ScopedBulkLoad(DocumentPtr doc) :
+        _doc(std::move(doc))
+    {
+        _doc->beginBulkLoad();
+    }
+    ~ScopedBulkLoad()
+    {
+        _doc->endBulkLoad();
+    }
+
+  private:
+    DocumentPtr _doc;
+};
+
 /// Create a new Document.
 /// @relates Document
 DocumentPtr createDocument();
@@ -9,6 +9,9 @@
 #include <MaterialXCore/Node.h>
 #include <MaterialXCore/Util.h>
 
+#include <mutex>
+#include <stdexcept>
+
 namespace MaterialX
 {
 
@@ -35,6 +38,55 @@ const string ValueElement::UI_MAX_ATTRIBUTE = "uimax";
 
 Element::CreatorMap Element::_creatorMap;
 
+namespace {
+
+// The initial capacity of attribute storage, covering the attribute counts of
+// most elements with a single allocation.
+const size_t ATTRIBUTE_RESERVE_COUNT = 4;
+
+// The attribute count above which attribute lookups are hashed rather than
+// scanned.
+const size_t ATTRIBUTE_INDEX_THRESHOLD = 16;
+
+// Serializes updates to cached name paths by concurrent readers.
+std::mutex namePathMutex;
+
+// Combine the given value into a running hash.
+void hashCombine(size_t& seed, size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+// Split the given name into a prefix and a numeric suffix, returning false
+// if the name does not end in a canonically formatted integer.
+bool splitNumericSuffix(const string& name, string& prefix, int& suffix)
+{
+    size_t split = name.length();
+    while (split > 0 && isdigit(name[split - 1]))
+    {
+        split--;
+    }
+    size_t digitCount = name.length() - split;
+    if (digitCount == 0 || digitCount > 9 || (digitCount > 1 && name[split] == '0'))
+    {
+        return false;
+    }
+    prefix = name.substr(0, split);
+    suffix = std::stoi(name.substr(split));
+    return true;
+}
+
+// Return the first offset within the given block, at or after the given
+// offset, that satisfies the given alignment.
+size_t alignOffset(const char* block, size_t offset, size_t alignment)
+{
+    size_t address = reinterpret_cast<size_t>(block) + offset;
+    size_t aligned = (address + alignment - 1) & ~(alignment - 1);
+    return aligned - reinterpret_cast<size_t>(block);
+}
+
+} // anonymous namespace
+
 //
 // Element methods
 //
@@ -47,14 +99,17 @@ bool Element::operator==(const Element& rhs) const
         return false;
     }
 
-    // Compare attributes.
-    if (getAttributeNames() != rhs.getAttributeNames())
+    // Element trees with differing content hashes cannot be equal.  Hashes
+    // are only compared when both are already cached, since computing them
+    // would cost as much as the comparison itself.
+    size_t hash = _contentHash.load(std::memory_order_acquire);
+    size_t rhsHash = rhs._contentHash.load(std::memory_order_acquire);
+    if (hash && rhsHash && hash != rhsHash)
+        return false;
+
+    // Compare attributes, whose interned names may be compared by address.
+    if (_attributes != rhs._attributes)
         return false;
-    for (const string& attr : rhs.getAttributeNames())
-    {
-        if (getAttribute(attr) != rhs.getAttribute(attr))
-            return false;
-    }
 
     // Compare children.
     const vector<ElementPtr>& c1 = getChildren();
@@ -74,6 +129,53 @@ bool Element::operator!=(const Element& rhs) const
     return !(*this == rhs);
 }
 
+size_t Element::getContentHash() const
+{
+    size_t hash = _contentHash.load(std::memory_order_acquire);
+    if (hash)
+    {
+        return hash;
+    }
+
+    std::hash<string> hashString;
+    hash = hashString(getCategory());
+    hashCombine(hash, hashString(getName()));
+    for (const Attribute& attr : _attributes)
+    {
+        hashCombine(hash, hashString(attr.first.str()));
+        hashCombine(hash, hashString(attr.second));
+    }
+    for (const ElementPtr& child : getChildren())
+    {
+        hashCombine(hash, child->getContentHash());
+    }
+
+    // A hash of zero is reserved to mark an invalid cache.
+    if (!hash)
+    {
+        hash = 1;
+    }
+    _contentHash.store(hash, std::memory_order_release);
+    return hash;
+}
+
+void Element::invalidateContentHash()
+{
+    // A valid hash implies valid hashes for all descendants, so the walk
+    // may stop at the first ancestor whose hash is already invalid.
+    if (!_contentHash.exchange(0))
+    {
+        return;
+    }
+    for (ElementPtr elem = getParent(); elem; elem = elem->getParent())
+    {
+        if (!elem->_contentHash.exchange(0))
+        {
+            break;
+        }
+    }
+}
+
 void Element::setName(const string& name)
 {
     DocumentPtr doc = getDocument();
@@ -85,37 +187,125 @@ void Element::setName(const string& name)
 
     // Handle change notifications.
     ScopedUpdate update(doc);
-    doc->onSetAttribute(getSelf(), NAME_ATTRIBUTE, name);
+    if (update.isActive())
+    {
+        doc->onSetAttribute(getSelf(), NAME_ATTRIBUTE, name);
+    }
+    else
+    {
+        doc->invalidateCache();
+    }
 
     if (parent)
     {
         parent->_childMap.erase(getName());
         parent->_childMap[name] = getSelf();
+        parent->releaseChildName(getName());
+        parent->_structureGeneration++;
     }
     _name = name;
+    invalidateContentHash();
+    invalidateNamePaths();
 }
 
 string Element::getNamePath(ConstElementPtr relativeTo) const
 {
-    if (!relativeTo)
+    ConstDocumentPtr doc = getDocument();
+    if (!relativeTo || relativeTo == doc)
     {
-        relativeTo = getDocument();
+        return getCachedNamePath();
     }
 
-    string res;
+    // Gather names up to the given ancestor, then join them in order.
+    vector<const string*> names;
+    size_t length = 0;
     for (ConstElementPtr elem = getSelf(); elem; elem = elem->getParent())
     {
         if (elem == relativeTo)
         {
             break;
         }
-        res = res.empty() ? elem->getName() : elem->getName() + NAME_PATH_SEPARATOR + res;
+        names.push_back(&elem->getName());
+        length += elem->getName().size() + NAME_PATH_SEPARATOR.size();
+    }
+
+    string res;
+    res.reserve(length);
+    for (auto it = names.rbegin(); it != names.rend(); ++it)
+    {
+        if (it != names.rbegin())
+        {
+            res += NAME_PATH_SEPARATOR;
+        }
+        res += **it;
     }
     return res;
 }
 
+const string& Element::getCachedNamePath() const
+{
+    if (_namePathValid.load(std::memory_order_acquire))
+    {
+        return _namePath;
+    }
+
+    // The root document contributes no name to the paths of its descendants.
+    string path;
+    ConstElementPtr parent = getParent();
+    if (parent)
+    {
+        const string& parentPath = parent->getCachedNamePath();
+        path = parentPath.empty() ? _name : parentPath + NAME_PATH_SEPARATOR + _name;
+    }
+
+    std::lock_guard<std::mutex> guard(namePathMutex);
+    if (!_namePathValid.load(std::memory_order_relaxed))
+    {
+        _namePath = std::move(path);
+        _namePathValid.store(true, std::memory_order_release);
+    }
+    return _namePath;
+}
+
+void Element::invalidateNamePaths()
+{
+    if (!_namePathValid.exchange(false))
+    {
+        // Descendant paths are only cached once this path has been cached.
+        return;
+    }
+    for (const ElementPtr& child : getChildren())
+    {
+        child->invalidateNamePaths();
+    }
+}
+
 ElementPtr Element::getDescendant(const string& namePath)
 {
+    if (namePath.empty())
+    {
+        return getSelf();
+    }
+
+    // Look up the full path in the document index, provided that this
+    // element is itself indexed.  The index is not maintained during a bulk
+    // load, so paths are walked directly instead.
+    DocumentPtr doc = _document.lock();
+    if (doc && !doc->isBulkLoading())
+    {
+        const string& prefix = getCachedNamePath();
+        if (prefix.empty() || doc->getIndexedElement(prefix) == getSelf())
+        {
+            ElementPtr elem = doc->getIndexedElement(prefix.empty() ? namePath : prefix + NAME_PATH_SEPARATOR + namePath);
+            if (elem)
+            {
+                return elem;
+            }
+        }
+    }
+
+    // Fall back to walking the path, which also handles non-canonical paths
+    // and elements detached from the document.
     const StringVec nameVec = splitString(namePath, NAME_PATH_SEPARATOR);
     ElementPtr elem = getSelf();
     for (const string& name : nameVec)
@@ -159,10 +349,20 @@ void Element::registerChildElement(ElementPtr child)
 
     // Handle change notifications.
     ScopedUpdate update(doc);
-    doc->onAddElement(getSelf(), child);
+    if (update.isActive())
+    {
+        doc->onAddElement(getSelf(), child);
+    }
+    else
+    {
+        doc->invalidateCache();
+    }
 
     _childMap[child->getName()] = child;
+    child->_childIndex = _childOrder.size();
     _childOrder.push_back(child);
+    _structureGeneration++;
+    invalidateContentHash();
 }
 
 void Element::unregisterChildElement(ElementPtr child)
@@ -171,40 +371,81 @@ void Element::unregisterChildElement(ElementPtr child)
 
     // Handle change notifications.
     ScopedUpdate update(doc);
-    doc->onRemoveElement(getSelf(), child);
+    if (update.isActive())
+    {
+        doc->onRemoveElement(getSelf(), child);
+    }
+    else
+    {
+        doc->invalidateCache();
+    }
 
+    // Leave an empty slot in the child order, to be removed by a later
+    // compaction.  Slots are compacted eagerly once they outnumber the
+    // remaining children, keeping removal amortized constant time.
     _childMap.erase(child->getName());
-    _childOrder.erase(
-        std::find(_childOrder.begin(), _childOrder.end(), child));
+    _childOrder[child->_childIndex].reset();
+    releaseChildName(child->getName());
+    _structureGeneration++;
+    invalidateContentHash();
+    size_t removedCount = _removedChildCount.load(std::memory_order_relaxed) + 1;
+    _removedChildCount.store(removedCount, std::memory_order_release);
+    if (removedCount * 2 > _childOrder.size())
+    {
+        compactChildOrder();
+    }
 }
 
 int Element::getChildIndex(const string& name) const
 {
     ElementPtr child = getChild(name);
-    vector<ElementPtr>::const_iterator it = std::find(_childOrder.begin(), _childOrder.end(), child);
-    if (it == _childOrder.end())
+    if (!child)
     {
         return -1;
     }
-    return (int) std::distance(_childOrder.begin(), it);
+    if (_removedChildCount.load(std::memory_order_acquire))
+    {
+        compactChildOrder();
+    }
+    return (int) child->_childIndex;
 }
 
 void Element::setChildIndex(const string& name, int index)
 {
     ElementPtr child = getChild(name);
-    vector<ElementPtr>::iterator it = std::find(_childOrder.begin(), _childOrder.end(), child);
-    if (it == _childOrder.end())
+    if (!child)
     {
         return;
     }
 
-    if (index < 0 || index > (int) _childOrder.size())
+    if (_removedChildCount.load(std::memory_order_acquire))
+    {
+        compactChildOrder();
+    }
+    if (index < 0 || index >= (int) _childOrder.size())
     {
         throw Exception("Invalid child index");
     }
 
-    _childOrder.erase(it);
-    _childOrder.insert(_childOrder.begin() + (size_t) index, child);
+    // Rotate the child into its new position, updating the stored indices
+    // of the children between its old and new positions.
+    size_t oldIndex = child->_childIndex;
+    size_t newIndex = (size_t) index;
+    vector<ElementPtr>::iterator begin = _childOrder.begin();
+    if (oldIndex < newIndex)
+    {
+        std::rotate(begin + oldIndex, begin + oldIndex + 1, begin + newIndex + 1);
+    }
+    else if (newIndex < oldIndex)
+    {
+        std::rotate(begin + newIndex, begin + oldIndex, begin + oldIndex + 1);
+    }
+    for (size_t i = std::min(oldIndex, newIndex); i <= std::max(oldIndex, newIndex); i++)
+    {
+        _childOrder[i]->_childIndex = i;
+    }
+    _structureGeneration++;
+    invalidateContentHash();
 }
 
 void Element::removeChild(const string& name)
@@ -218,35 +459,121 @@ void Element::removeChild(const string& name)
     unregisterChildElement(it->second);
 }
 
+void Element::compactChildOrder() const
+{
+    std::lock_guard<std::mutex> guard(_childOrderMutex);
+    if (!_removedChildCount.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < _childOrder.size(); i++)
+    {
+        if (!_childOrder[i])
+        {
+            continue;
+        }
+        if (i != count)
+        {
+            _childOrder[count] = std::move(_childOrder[i]);
+        }
+        _childOrder[count]->_childIndex = count;
+        count++;
+    }
+    _childOrder.resize(count);
+    _removedChildCount.store(0, std::memory_order_release);
+}
+
+void Element::releaseChildName(const string& name)
+{
+    if (!_childNameSuffixes)
+    {
+        return;
+    }
+
+    string prefix;
+    int suffix;
+    if (!splitNumericSuffix(name, prefix, suffix))
+    {
+        return;
+    }
+
+    NameSuffixMap::iterator it = _childNameSuffixes->find(prefix);
+    if (it != _childNameSuffixes->end() &&
+        suffix >= it->second.first &&
+        suffix < it->second.second)
+    {
+        it->second.second = suffix;
+    }
+}
+
 void Element::setAttribute(const string& attrib, const string& value)
 {
     DocumentPtr doc = getDocument();
 
     // Handle change notifications.
     ScopedUpdate update(doc);
-    doc->onSetAttribute(getSelf(), attrib, value);
+    if (update.isActive())
+    {
+        doc->onSetAttribute(getSelf(), attrib, value);
+    }
+    else
+    {
+        doc->invalidateCache();
+    }
 
-    if (!_attributeMap.count(attrib))
+    AttributeVec::iterator it = findAttribute(attrib);
+    if (it == _attributes.end())
+    {
+        if (_attributes.empty())
+        {
+            _attributes.reserve(ATTRIBUTE_RESERVE_COUNT);
+        }
+        bool reallocated = _attributes.size() == _attributes.capacity();
+        _attributes.emplace_back(InternedString(attrib), value);
+        if (_attributeIndex && !reallocated)
+        {
+            (*_attributeIndex)[&_attributes.back().first.str()] = _attributes.size() - 1;
+        }
+        else if (_attributes.size() > ATTRIBUTE_INDEX_THRESHOLD)
+        {
+            updateAttributeIndex();
+        }
+    }
+    else
     {
-        _attributeOrder.push_back(attrib);
+        it->second = value;
     }
-    _attributeMap[attrib] = value;
+    invalidateContentHash();
+    attributeModified(attrib);
 }
 
 void Element::removeAttribute(const string& attrib)
 {
-    StringMap::iterator it = _attributeMap.find(attrib);
-    if (it != _attributeMap.end())
+    AttributeVec::iterator it = findAttribute(attrib);
+    if (it != _attributes.end())
     {
         DocumentPtr doc = getDocument();
 
         // Handle change notifications.
         ScopedUpdate update(doc);
-        doc->onRemoveAttribute(getSelf(), attrib);
+        if (update.isActive())
+        {
+            doc->onRemoveAttribute(getSelf(), attrib);
+        }
+        else
+        {
+            doc->invalidateCache();
+        }
 
-        _attributeMap.erase(it);
-        _attributeOrder.erase(
-            std::find(_attributeOrder.begin(), _attributeOrder.end(), attrib));
+        _attributes.erase(it);
+        if (_attributeIndex)
+        {
+            updateAttributeIndex();
+        }
+        invalidateContentHash();
+        attributeModified(attrib);
     }
 }
 
@@ -305,22 +632,37 @@ ElementPtr Element::addChildOfCategory(const string& category,
 
 ElementPtr Element::getRoot()
 {
-    ElementPtr root = _root.lock();
-    if (!root)
+    return getDocument();
+}
+
+ConstElementPtr Element::getRoot() const
+{
+    return getDocument();
+}
+
+Element::DocumentPtr Element::getDocument()
+{
+    DocumentPtr doc = _document.lock();
+    if (!doc)
     {
         throw ExceptionOrphanedElement("Requested root of orphaned element: " + asString());
     }
-    return root;
+    return doc;
 }
 
-ConstElementPtr Element::getRoot() const
+Element::ConstDocumentPtr Element::getDocument() const
 {
-    ElementPtr root = _root.lock();
-    if (!root)
+    DocumentPtr doc = _document.lock();
+    if (!doc)
     {
         throw ExceptionOrphanedElement("Requested root of orphaned element: " + asString());
     }
-    return root;
+    return doc;
+}
+
+ElementArenaPtr Element::getElementArena() const
+{
+    return getDocument()->getElementArena();
 }
 
 bool Element::hasInheritedBase(ConstElementPtr base) const
@@ -380,11 +722,20 @@ void Element::copyContentFrom(ConstElementPtr source, const CopyOptions* copyOpt
 
     // Handle change notifications.
     ScopedUpdate update(doc);
-    doc->onCopyContent(getSelf());
+    if (update.isActive())
+    {
+        doc->onCopyContent(getSelf());
+    }
+    else
+    {
+        doc->invalidateCache();
+    }
 
     _sourceUri = source->_sourceUri;
-    _attributeMap = source->_attributeMap;
-    _attributeOrder = source->_attributeOrder;
+    _attributes = source->_attributes;
+    updateAttributeIndex();
+    invalidateContentHash();
+    attributeModified(EMPTY_STRING);
 
     for (ElementPtr child : source->getChildren())
     {
@@ -398,17 +749,70 @@ void Element::copyContentFrom(ConstElementPtr source, const CopyOptions* copyOpt
     }
 }
 
+string Element::createValidChildName(string name) const
+{
+    name = createValidName(name);
+    if (!_childMap.count(name))
+    {
+        return name;
+    }
+
+    name = incrementName(name);
+    string prefix;
+    int suffix;
+    if (!splitNumericSuffix(name, prefix, suffix))
+    {
+        while (_childMap.count(name))
+        {
+            name = incrementName(name);
+        }
+        return name;
+    }
+
+    // Skip past the suffixes known to be in use for this prefix, so that
+    // repeated requests for the same prefix take amortized constant time.
+    std::lock_guard<std::mutex> guard(_childOrderMutex);
+    if (!_childNameSuffixes)
+    {
+        _childNameSuffixes.reset(new NameSuffixMap);
+    }
+    std::pair<int, int>& range = (*_childNameSuffixes)[prefix];
+    if (suffix >= range.first && suffix <= range.second)
+    {
+        suffix = range.second;
+    }
+    else
+    {
+        range.first = suffix;
+    }
+    while (_childMap.count(prefix + std::to_string(suffix)))
+    {
+        suffix++;
+    }
+    range.second = suffix;
+    return prefix + std::to_string(suffix);
+}
+
 void Element::clearContent()
 {
     DocumentPtr doc = getDocument();
 
     // Handle change notifications.
     ScopedUpdate update(doc);
-    doc->onClearContent(getSelf());
+    if (update.isActive())
+    {
+        doc->onClearContent(getSelf());
+    }
+    else
+    {
+        doc->invalidateCache();
+    }
 
     _sourceUri = EMPTY_STRING;
-    _attributeMap.clear();
-    _attributeOrder.clear();
+    _attributes.clear();
+    _attributeIndex.reset();
+    invalidateContentHash();
+    attributeModified(EMPTY_STRING);
 
     vector<ElementPtr> children = getChildren();
     for (ElementPtr child : children)
@@ -426,11 +830,18 @@ bool Element::validate(string* message) const
         bool validInherit = getInheritsFrom() && getInheritsFrom()->getCategory() == getCategory();
         validateRequire(validInherit, res, message, "Invalid element inheritance");
     }
+    res = validateChildren(message) && res;
+    validateRequire(!hasInheritanceCycle(), res, message, "Cycle in element inheritance chain");
+    return res;
+}
+
+bool Element::validateChildren(string* message) const
+{
+    bool res = true;
     for (ElementPtr child : getChildren())
     {
         res = child->validate(message) && res;
     }
-    validateRequire(!hasInheritanceCycle(), res, message, "Cycle in element inheritance chain");
     return res;
 }
 
@@ -486,14 +897,33 @@ string Element::asString() const
     {
         res += " name=\"" + getName() + "\"";
     }
-    for (const string& attrName : getAttributeNames())
+    for (const Attribute& attr : _attributes)
     {
-        res += " " + attrName + "=\"" + getAttribute(attrName) + "\"";
+        res += " " + attr.first.str() + "=\"" + attr.second + "\"";
     }
     res += ">";
     return res;
 }
 
+void Element::updateAttributeIndex()
+{
+    if (_attributes.size() <= ATTRIBUTE_INDEX_THRESHOLD)
+    {
+        _attributeIndex.reset();
+        return;
+    }
+
+    if (!_attributeIndex)
+    {
+        _attributeIndex.reset(new AttributeIndex);
+    }
+    _attributeIndex->clear();
+    for (size_t i = 0; i < _attributes.size(); i++)
+    {
+        (*_attributeIndex)[&_attributes[i].first.str()] = i;
+    }
+}
+
 void Element::validateRequire(bool expression, bool& res, string* message, string errorDesc) const
 {
     if (!expression)
@@ -546,6 +976,22 @@ ValuePtr ValueElement::getBoundValue(ConstMaterialPtr material) const
     return ValuePtr();
 }
 
+ValuePtr ValueElement::getValue() const
+{
+    if (!hasValue())
+        return ValuePtr();
+
+    // Concurrent readers may share the cached value, so it is accessed
+    // atomically.
+    ValuePtr value = std::atomic_load(&_cachedValue);
+    if (!value)
+    {
+        value = Value::createValueFromStrings(getValueString(), getType());
+        std::atomic_store(&_cachedValue, value);
+    }
+    return value;
+}
+
 ValuePtr ValueElement::getDefaultValue() const
 {
     if (hasValue())
@@ -571,6 +1017,14 @@ ValuePtr ValueElement::getDefaultValue() const
     return ValuePtr();
 }
 
+void ValueElement::attributeModified(const string& attrib)
+{
+    if (attrib.empty() || attrib == VALUE_ATTRIBUTE || attrib == TYPE_ATTRIBUTE)
+    {
+        std::atomic_store(&_cachedValue, ValuePtr());
+    }
+}
+
 bool ValueElement::validate(string* message) const
 {
     bool res = true;
@@ -651,6 +1105,46 @@ string StringResolver::resolve(const string& str, const string& type) const
     return str;
 }
 
+//
+// ElementArena methods
+//
+
+const size_t ElementArena::DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+void* ElementArena::allocate(size_t size, size_t alignment)
+{
+    // Allocate from the current block if it has room.
+    if (!_blocks.empty())
+    {
+        char* block = _blocks.back().first.get();
+        size_t offset = alignOffset(block, _blockOffset, alignment);
+        if (offset + size <= _blocks.back().second)
+        {
+            _blockOffset = offset + size;
+            return block + offset;
+        }
+    }
+
+    // Otherwise, start a new block.  Allocations larger than the block size
+    // receive a dedicated block of their own.
+    size_t blockSize = std::max(_blockSize, size + alignment);
+    _blocks.emplace_back(std::unique_ptr<char[]>(new char[blockSize]), blockSize);
+    char* block = _blocks.back().first.get();
+    size_t offset = alignOffset(block, 0, alignment);
+    _blockOffset = offset + size;
+    return block + offset;
+}
+
+size_t ElementArena::getReservedSize() const
+{
+    size_t size = 0;
+    for (const auto& block : _blocks)
+    {
+        size += block.second;
+    }
+    return size;
+}
+
 //
 // Global functions
 //
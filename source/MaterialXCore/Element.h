@@ -15,6 +15,9 @@
 #include <MaterialXCore/Util.h>
 #include <MaterialXCore/Value.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace MaterialX
 {
 
@@ -26,6 +29,7 @@ class StringResolver;
 class Document;
 class Material;
 class CopyOptions;
+class ElementArena;
 
 /// A shared pointer to an Element
 using ElementPtr = shared_ptr<Element>;
@@ -50,6 +54,9 @@ using ConstTokenPtr = shared_ptr<const Token>;
 /// A shared pointer to a StringResolver
 using StringResolverPtr = shared_ptr<StringResolver>;
 
+/// A shared pointer to an ElementArena
+using ElementArenaPtr = shared_ptr<ElementArena>;
+
 /// A hash map from strings to elements
 using ElementMap = std::unordered_map<string, ElementPtr>;
 
@@ -67,8 +74,13 @@ class Element : public std::enable_shared_from_this<Element>
     Element(ElementPtr parent, const string& category, const string& name) :
         _category(category),
         _name(name),
+        _removedChildCount(0),
         _parent(parent),
-        _root(parent ? parent->getRoot() : nullptr)
+        _childIndex(0),
+        _contentHash(0),
+        _structureGeneration(0),
+        _namePathValid(false),
+        _document(parent ? parent->_document : weak_ptr<Document>())
     {
     }
   public:
@@ -80,6 +92,8 @@ class Element : public std::enable_shared_from_this<Element>
     using ConstMaterialPtr = shared_ptr<const Material>;
 
     template <class T> friend class ElementRegistry;
+    friend class Document;
+    friend class InterfaceElement;
 
   public:
     /// Return true if the given element tree, including all descendants,
@@ -90,13 +104,21 @@ class Element : public std::enable_shared_from_this<Element>
     /// differs from this one.
     bool operator!=(const Element& rhs) const;
 
+    /// Return a hash of the given element tree, combining the category, name,
+    /// and attributes of each element with the hashes of its children.  The
+    /// hash is cached, and is invalidated when the element or any of its
+    /// descendants is modified.  Element trees that compare equal have equal
+    /// content hashes.
+    size_t getContentHash() const;
+
     /// @name Category
     /// @{
 
     /// Set the element's category string.
     void setCategory(const string& category)
     {
-        _category = category;
+        _category = InternedString(category);
+        invalidateContentHash();
     }
 
     /// Return the element's category string.  The category of a MaterialX
@@ -104,7 +126,7 @@ class Element : public std::enable_shared_from_this<Element>
     /// being "material", "nodegraph", and "image".
     const string& getCategory() const
     {
-        return _category;
+        return _category.str();
     }
 
     /// @}
@@ -125,7 +147,9 @@ class Element : public std::enable_shared_from_this<Element>
 
     /// Return the element's hierarchical name path, relative to the root
     /// document.  The name of each ancestor will be prepended in turn,
-    /// separated by forward slashes.
+    /// separated by forward slashes.  Paths relative to the root document
+    /// are cached, and are invalidated when the element or an ancestor is
+    /// renamed.
     /// @param relativeTo If a valid ancestor element is specified, then
     ///    the returned path will be relative to this ancestor.
     string getNamePath(ConstElementPtr relativeTo = nullptr) const;
@@ -133,7 +157,8 @@ class Element : public std::enable_shared_from_this<Element>
     /// Return the element specified by the given hierarchical name path,
     /// relative to the current element.  If the name path is empty then the
     /// current element is returned.  If no element is found at the given path,
-    /// then an empty shared pointer is returned.
+    /// then an empty shared pointer is returned.  Paths are resolved through
+    /// the name path index of the document where possible.
     /// @param namePath The relative name path of the specified element.
     ElementPtr getDescendant(const string& namePath);
 
@@ -275,6 +300,7 @@ class Element : public std::enable_shared_from_this<Element>
     void setInheritString(const string& inherit)
     {
         setAttribute(INHERIT_ATTRIBUTE, inherit);
+        _structureGeneration++;
     }
 
     /// Return true if this element has an inherit string.
@@ -299,6 +325,7 @@ class Element : public std::enable_shared_from_this<Element>
         else
         {
             removeAttribute(INHERIT_ATTRIBUTE);
+            _structureGeneration++;
         }
     }
 
@@ -461,8 +488,15 @@ class Element : public std::enable_shared_from_this<Element>
 
     /// Return a constant vector of all child elements.
     /// The returned vector maintains the order in which children were added.
+    /// Removing a child may leave a null entry in its place within a vector
+    /// returned by an earlier call, so callers that remove children while
+    /// iterating should iterate over a copy of the returned vector.
     const vector<ElementPtr>& getChildren() const
     {
+        if (_removedChildCount.load(std::memory_order_acquire))
+        {
+            compactChildOrder();
+        }
         return _childOrder;
     }
 
@@ -472,7 +506,7 @@ class Element : public std::enable_shared_from_this<Element>
     template<class T> vector< shared_ptr<T> > getChildrenOfType(const string& category = EMPTY_STRING) const
     {
         vector< shared_ptr<T> > children;
-        for (ElementPtr child : _childOrder)
+        for (ElementPtr child : getChildren())
         {
             shared_ptr<T> instance = child->asA<T>();
             if (!instance)
@@ -508,30 +542,49 @@ class Element : public std::enable_shared_from_this<Element>
     /// @name Attributes
     /// @{
 
+    /// An attribute of an element, stored as a pair of name and value strings.
+    using Attribute = std::pair<InternedString, string>;
+
+    /// A vector of attributes, in the order they were set.
+    using AttributeVec = vector<Attribute>;
+
     /// Set the value string of the given attribute.
     void setAttribute(const string& attrib, const string& value);
 
     /// Return true if the given attribute is present.
     bool hasAttribute(const string& attrib) const
     {
-        return _attributeMap.count(attrib) != 0;
+        return findAttribute(attrib) != _attributes.end();
     }
 
     /// Return the value string of the given attribute.  If the given attribute
     /// is not present, then an empty string is returned.
     const string& getAttribute(const string& attrib) const
     {
-        StringMap::const_iterator it = _attributeMap.find(attrib);
-        if (it == _attributeMap.end())
+        AttributeVec::const_iterator it = findAttribute(attrib);
+        if (it == _attributes.end())
             return EMPTY_STRING;
         else
             return it->second;
     }
 
     /// Return a vector of stored attribute names, in the order they were set.
-    const StringVec& getAttributeNames() const
+    StringVec getAttributeNames() const
     {
-        return _attributeOrder;
+        StringVec names;
+        names.reserve(_attributes.size());
+        for (const Attribute& attr : _attributes)
+        {
+            names.push_back(attr.first.str());
+        }
+        return names;
+    }
+
+    /// Return the stored (name, value) pairs of attributes, in the order
+    /// they were set.
+    const AttributeVec& getAttributes() const
+    {
+        return _attributes;
     }
 
     /// Set the value of an implicitly typed attribute.  Since an attribute
@@ -594,17 +647,19 @@ class Element : public std::enable_shared_from_this<Element>
     /// Return the root element of our tree.
     ConstElementPtr getRoot() const;
 
-    /// Return the root document of our tree.
-    DocumentPtr getDocument()
-    {
-        return getRoot()->asA<Document>();
-    }
+    /// Return the root document of our tree.  Each element stores a direct
+    /// reference to its document, so this method runs in constant time.
+    /// @throws ExceptionOrphanedElement if the document has been destroyed.
+    DocumentPtr getDocument();
 
-    /// Return the root document of our tree.
-    ConstDocumentPtr getDocument() const
-    {
-        return getRoot()->asA<Document>();
-    }
+    /// Return the root document of our tree.  Each element stores a direct
+    /// reference to its document, so this method runs in constant time.
+    /// @throws ExceptionOrphanedElement if the document has been destroyed.
+    ConstDocumentPtr getDocument() const;
+
+    /// Return the memory arena, if any, from which new elements in our
+    /// document are allocated.
+    virtual ElementArenaPtr getElementArena() const;
 
     /// Return the first ancestor of the given subclass, or an empty shared
     /// pointer if no ancestor of this subclass is found.
@@ -778,15 +833,7 @@ class Element : public std::enable_shared_from_this<Element>
 
     /// Using the input name as a starting point, modify it to create a valid,
     /// unique name for a child element.
-    string createValidChildName(string name) const
-    {
-        name = createValidName(name);
-        while (_childMap.count(name))
-        {
-            name = incrementName(name);
-        }
-        return name;
-    }
+    string createValidChildName(string name) const;
 
     /// Construct a StringResolver at the scope of this element.  The returned
     /// object may be used to apply substring modifiers to data values in the
@@ -826,6 +873,10 @@ class Element : public std::enable_shared_from_this<Element>
         return child ? child : root->getChildOfType<T>(name);
     }
 
+    // Validate each child of this element, returning true if all children
+    // pass validation.
+    virtual bool validateChildren(string* message) const;
+
     // Enforce a requirement within a validate method, updating the validation
     // state and optional output text if the requirement is not met.
     void validateRequire(bool expression, bool& res, string* message, string errorDesc) const;
@@ -842,9 +893,89 @@ class Element : public std::enable_shared_from_this<Element>
     static const string NAMESPACE_ATTRIBUTE;
 
   protected:
+    // Elements with many attributes maintain a hashed index from the names
+    // stored in the attribute vector to their positions, which is rebuilt
+    // whenever the vector is reallocated.
+    struct AttributeNameHash
+    {
+        size_t operator()(const string* name) const
+        {
+            return std::hash<string>()(*name);
+        }
+    };
+    struct AttributeNameEqual
+    {
+        bool operator()(const string* lhs, const string* rhs) const
+        {
+            return lhs == rhs || *lhs == *rhs;
+        }
+    };
+    using AttributeIndex = std::unordered_map<const string*, size_t, AttributeNameHash, AttributeNameEqual>;
+
+    // A map from child name prefixes to ranges [begin, end) of numeric
+    // suffixes known to be in use by children of this element.
+    using NameSuffixMap = std::unordered_map<string, std::pair<int, int>>;
+
     virtual void registerChildElement(ElementPtr child);
     virtual void unregisterChildElement(ElementPtr child);
 
+    // Return the stored attribute with the given name, comparing interned
+    // names by address before falling back to a string comparison.
+    AttributeVec::iterator findAttribute(const string& attrib)
+    {
+        if (_attributeIndex)
+        {
+            AttributeIndex::const_iterator it = _attributeIndex->find(&attrib);
+            return it != _attributeIndex->end() ? _attributes.begin() + it->second : _attributes.end();
+        }
+        return std::find_if(_attributes.begin(), _attributes.end(),
+            [&attrib](const Attribute& attr)
+            {
+                return attr.first == attrib;
+            });
+    }
+    AttributeVec::const_iterator findAttribute(const string& attrib) const
+    {
+        if (_attributeIndex)
+        {
+            AttributeIndex::const_iterator it = _attributeIndex->find(&attrib);
+            return it != _attributeIndex->end() ? _attributes.begin() + it->second : _attributes.end();
+        }
+        return std::find_if(_attributes.begin(), _attributes.end(),
+            [&attrib](const Attribute& attr)
+            {
+                return attr.first == attrib;
+            });
+    }
+
+    // Rebuild or discard the hashed attribute index to match the current
+    // attribute count.
+    void updateAttributeIndex();
+
+    // Remove the empty slots left in the child order by removed children,
+    // and update the stored index of each remaining child.
+    void compactChildOrder() const;
+
+    // Update the ranges of used child name suffixes after the given child
+    // name has been released.
+    void releaseChildName(const string& name);
+
+    // Invalidate the cached content hash of this element and its ancestors.
+    void invalidateContentHash();
+
+    // Return the cached name path of this element relative to the root,
+    // computing it from the cached path of its parent if needed.
+    const string& getCachedNamePath() const;
+
+    // Invalidate the cached name paths of this element and its descendants.
+    void invalidateNamePaths();
+
+    // Called after the given attribute of this element has been set or
+    // removed, allowing subclasses to discard state derived from attribute
+    // values.  An empty attribute name indicates that any attribute may have
+    // changed.
+    virtual void attributeModified(const string&) { }
+
     // Return a non-const copy of our self pointer, for use in constructing
     // graph traversal objects that require non-const storage.
     ElementPtr getSelfNonConst() const
@@ -853,18 +984,29 @@ class Element : public std::enable_shared_from_this<Element>
     }
 
   protected:
-    string _category;
+    InternedString _category;
     string _name;
     string _sourceUri;
 
     ElementMap _childMap;
-    vector<ElementPtr> _childOrder;
+    mutable vector<ElementPtr> _childOrder;
+    mutable std::atomic<size_t> _removedChildCount;
+    mutable std::unique_ptr<NameSuffixMap> _childNameSuffixes;
+
+    // Serializes the compaction of the child order and updates to child
+    // name suffix ranges by concurrent readers of this element.
+    mutable std::mutex _childOrderMutex;
 
-    StringMap _attributeMap;
-    StringVec _attributeOrder;
+    AttributeVec _attributes;
+    std::unique_ptr<AttributeIndex> _attributeIndex;
 
     weak_ptr<Element> _parent;
-    weak_ptr<Element> _root;
+    mutable size_t _childIndex;
+    mutable std::atomic<size_t> _contentHash;
+    size_t _structureGeneration;
+    mutable string _namePath;
+    mutable std::atomic<bool> _namePathValid;
+    weak_ptr<Document> _document;
 
   private:
     Element(const Element&) = delete;
@@ -872,9 +1014,11 @@ class Element : public std::enable_shared_from_this<Element>
 
     template <class T> static ElementPtr createElement(ElementPtr parent, const string& name)
     {
-        return std::make_shared<T>(parent, name);
+        return allocateElement<T>(parent, name);
     }
 
+    template <class T> static shared_ptr<T> allocateElement(ElementPtr parent, const string& name);
+
   private:
     using CreatorFunction = ElementPtr (*)(ElementPtr, const string&);
     using CreatorMap = std::unordered_map<string, CreatorFunction>;
@@ -1043,14 +1187,13 @@ class ValueElement : public TypedElement
     /// Return the typed value of an element as a generic value object, which
     /// may be queried to access its data.
     ///
+    /// The parsed value is cached until the value or type of the element
+    /// changes, and the returned object is shared between callers, so it
+    /// should not be modified.
+    ///
     /// @return A shared pointer to the typed value of this element, or an
     ///    empty shared pointer if no value is present.
-    ValuePtr getValue() const
-    {
-        if (!hasValue())
-            return ValuePtr();
-        return Value::createValueFromStrings(getValueString(), getType());
-    }
+    ValuePtr getValue() const;
 
     /// Return the resolved value of an element as a generic value object, which
     /// may be queried to access its data.
@@ -1105,6 +1248,12 @@ class ValueElement : public TypedElement
 
     /// @}
 
+  protected:
+    void attributeModified(const string& attrib) override;
+
+  private:
+    mutable ValuePtr _cachedValue;
+
   public:
     static const string VALUE_ATTRIBUTE;
     static const string PUBLIC_NAME_ATTRIBUTE;
@@ -1296,6 +1445,88 @@ class CopyOptions
     bool skipDuplicateElements;
 };
 
+/// @class ElementArena
+/// A memory arena for the allocation of elements.
+///
+/// An ElementArena hands out memory from large contiguous blocks, and releases
+/// all of its blocks at once when it is destroyed.  Individual deallocations
+/// are ignored, so memory for elements that are removed from a document is
+/// only reclaimed when the arena itself is released.
+///
+/// Elements allocated from an arena hold a reference to it, so the arena
+/// remains valid until the last of its elements has been destroyed.
+class ElementArena
+{
+  public:
+    explicit ElementArena(size_t blockSize = DEFAULT_BLOCK_SIZE) :
+        _blockSize(blockSize),
+        _blockOffset(0)
+    {
+    }
+    ~ElementArena() { }
+
+    /// Allocate the given number of bytes with the given alignment.
+    void* allocate(size_t size, size_t alignment);
+
+    /// Return the total number of bytes reserved by the arena.
+    size_t getReservedSize() const;
+
+  public:
+    static const size_t DEFAULT_BLOCK_SIZE;
+
+  private:
+    ElementArena(const ElementArena&) = delete;
+    ElementArena& operator=(const ElementArena&) = delete;
+
+  private:
+    size_t _blockSize;
+    size_t _blockOffset;
+    vector<std::pair<std::unique_ptr<char[]>, size_t>> _blocks;
+};
+
+/// @class ElementAllocator
+/// A standard allocator that draws its memory from an ElementArena.
+template <class T> class ElementAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit ElementAllocator(ElementArenaPtr arena) :
+        _arena(arena)
+    {
+    }
+    template <class U> ElementAllocator(const ElementAllocator<U>& other) :
+        _arena(other.getArena())
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t)
+    {
+    }
+
+    ElementArenaPtr getArena() const
+    {
+        return _arena;
+    }
+
+    template <class U> bool operator==(const ElementAllocator<U>& rhs) const
+    {
+        return _arena == rhs.getArena();
+    }
+    template <class U> bool operator!=(const ElementAllocator<U>& rhs) const
+    {
+        return _arena != rhs.getArena();
+    }
+
+  private:
+    ElementArenaPtr _arena;
+};
+
 /// @class ExceptionOrphanedElement
 /// An exception that is thrown when an ElementPtr is used after its owning
 /// Document has gone out of scope.
@@ -1305,6 +1536,16 @@ class ExceptionOrphanedElement : public Exception
     using Exception::Exception;
 };
 
+template <class T> shared_ptr<T> Element::allocateElement(ElementPtr parent, const string& name)
+{
+    ElementArenaPtr arena = parent ? parent->getElementArena() : nullptr;
+    if (arena)
+    {
+        return std::allocate_shared<T>(ElementAllocator<T>(arena), parent, name);
+    }
+    return std::make_shared<T>(parent, name);
+}
+
 template<class T> shared_ptr<T> Element::addChild(const string& name)
 {
     string childName = name;
@@ -1316,7 +1557,7 @@ template<class T> shared_ptr<T> Element::addChild(const string& name)
     if (_childMap.count(childName))
         throw Exception("Child name is not unique: " + childName);
 
-    shared_ptr<T> child = std::make_shared<T>(getSelf(), childName);
+    shared_ptr<T> child = allocateElement<T>(getSelf(), childName);
     registerChildElement(child);
 
     return child;
@@ -7,6 +7,8 @@
 
 #include <MaterialXCore/Document.h>
 
+#include <thread>
+
 namespace MaterialX
 {
 
@@ -25,19 +27,116 @@ const string Collection::INCLUDE_GEOM_ATTRIBUTE = "includegeom";
 const string Collection::EXCLUDE_GEOM_ATTRIBUTE = "excludegeom";
 const string Collection::INCLUDE_COLLECTION_ATTRIBUTE = "includecollection";
 
-bool geomStringsMatch(const string& geom1, const string& geom2, bool contains)
+namespace {
+
+// The smallest number of geometry queries worth handing to a worker thread.
+const size_t MIN_QUERIES_PER_THREAD = 256;
+
+// Find the next token in the given string that is delimited by any of the
+// given separators, starting the search at pos.  On success, the token spans
+// [begin, pos), and true is returned.
+bool nextToken(const string& str, const string& sep, size_t& pos, size_t& begin, size_t end = string::npos)
 {
-    vector<GeomPath> paths1;
-    for (const string& name1 : splitString(geom1, ARRAY_VALID_SEPARATORS))
+    end = std::min(end, str.size());
+    while (pos < end && sep.find(str[pos]) != string::npos)
+    {
+        pos++;
+    }
+    if (pos >= end)
     {
-        paths1.push_back(GeomPath(name1));
+        return false;
     }
-    for (const string& name2 : splitString(geom2, ARRAY_VALID_SEPARATORS))
+    begin = pos;
+    while (pos < end && sep.find(str[pos]) == string::npos)
     {
-        GeomPath path2(name2);
-        for (const GeomPath& path1 : paths1)
+        pos++;
+    }
+    return true;
+}
+
+// Return true if the geom names spanning [begin1, end1) of str1 and
+// [begin2, end2) of str2 have any geometry in common, comparing path
+// components in place.
+bool geomNamesMatch(const string& str1, size_t begin1, size_t end1,
+                    const string& str2, size_t begin2, size_t end2,
+                    bool contains)
+{
+    size_t pos1 = begin1, pos2 = begin2;
+    size_t comp1, comp2;
+    while (true)
+    {
+        bool has1 = nextToken(str1, GEOM_PATH_SEPARATOR, pos1, comp1, end1);
+        bool has2 = nextToken(str2, GEOM_PATH_SEPARATOR, pos2, comp2, end2);
+        if (!has1)
+        {
+            return true;
+        }
+        if (!has2)
         {
-            if (path1.isMatching(path2, contains))
+            return !contains;
+        }
+        if (str1.compare(comp1, pos1 - comp1, str2, comp2, pos2 - comp2) != 0)
+        {
+            return false;
+        }
+    }
+}
+
+// Apply a function to each index in [0, count), distributing consecutive
+// ranges of indices across up to threadCount threads.
+template <class F> void forEachIndex(size_t count, unsigned int threadCount, F func)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    size_t rangeCount = std::min((size_t) threadCount, std::max(count / MIN_QUERIES_PER_THREAD, (size_t) 1));
+    size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+    vector<std::exception_ptr> exceptions(rangeCount);
+    auto applyRange = [&func, &exceptions, rangeSize, count](size_t range)
+    {
+        try
+        {
+            for (size_t i = range * rangeSize; i < std::min((range + 1) * rangeSize, count); i++)
+            {
+                func(i);
+            }
+        }
+        catch (...)
+        {
+            exceptions[range] = std::current_exception();
+        }
+    };
+    vector<std::thread> threads;
+    for (size_t range = 1; range < rangeCount; range++)
+    {
+        threads.emplace_back(applyRange, range);
+    }
+    applyRange(0);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    for (std::exception_ptr& exception : exceptions)
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+} // anonymous namespace
+
+bool geomStringsMatch(const string& geom1, const string& geom2, bool contains)
+{
+    size_t pos2 = 0, begin2;
+    while (nextToken(geom2, ARRAY_VALID_SEPARATORS, pos2, begin2))
+    {
+        size_t pos1 = 0, begin1;
+        while (nextToken(geom1, ARRAY_VALID_SEPARATORS, pos1, begin1))
+        {
+            if (geomNamesMatch(geom1, begin1, pos1, geom2, begin2, pos2, contains))
             {
                 return true;
             }
@@ -46,6 +145,151 @@ bool geomStringsMatch(const string& geom1, const string& geom2, bool contains)
     return false;
 }
 
+//
+// GeomPathIndex methods
+//
+
+GeomPathIndex::GeomPathIndex() :
+    _nodes(1)
+{
+}
+
+void GeomPathIndex::addElement(ElementPtr elem, const string& geom, ConstCollectionPtr collection)
+{
+    size_t elemIndex = _elements.size();
+    _elements.push_back(elem);
+
+    // Each geom name is stored at the trie node for its final path component,
+    // with the universal geom name stored at the root.
+    string component;
+    size_t pos = 0, begin;
+    while (nextToken(geom, ARRAY_VALID_SEPARATORS, pos, begin))
+    {
+        size_t node = 0;
+        size_t compPos = begin, compBegin;
+        while (nextToken(geom, GEOM_PATH_SEPARATOR, compPos, compBegin, pos))
+        {
+            component.assign(geom, compBegin, compPos - compBegin);
+            auto it = _nodes[node].children.find(component);
+            if (it != _nodes[node].children.end())
+            {
+                node = it->second;
+            }
+            else
+            {
+                _nodes[node].children[component] = _nodes.size();
+                node = _nodes.size();
+                _nodes.emplace_back();
+            }
+        }
+        vector<size_t>& nodeElements = _nodes[node].elements;
+        if (nodeElements.empty() || nodeElements.back() != elemIndex)
+        {
+            nodeElements.push_back(elemIndex);
+        }
+    }
+
+    if (collection)
+    {
+        _collectionElements.emplace_back(elemIndex, collection);
+    }
+}
+
+vector<ElementPtr> GeomPathIndex::getMatchingElements(const string& geom) const
+{
+    vector<size_t> matches;
+    addMatches(geom, matches);
+    vector<ElementPtr> elements;
+    elements.reserve(matches.size());
+    for (size_t elemIndex : matches)
+    {
+        elements.push_back(_elements[elemIndex]);
+    }
+    return elements;
+}
+
+vector<vector<ElementPtr>> GeomPathIndex::getMatchingElements(const StringVec& geoms, unsigned int threadCount) const
+{
+    vector<vector<ElementPtr>> results(geoms.size());
+    forEachIndex(geoms.size(), threadCount, [this, &geoms, &results](size_t i)
+    {
+        results[i] = getMatchingElements(geoms[i]);
+    });
+    return results;
+}
+
+void GeomPathIndex::addMatches(const string& geom, vector<size_t>& matches) const
+{
+    string component;
+    vector<size_t> nodeStack;
+    size_t pos = 0, begin;
+    while (nextToken(geom, ARRAY_VALID_SEPARATORS, pos, begin))
+    {
+        // Indexed paths that contain the queried path lie along its branch
+        // of the trie.
+        size_t node = 0;
+        bool foundNode = true;
+        size_t compPos = begin, compBegin;
+        while (true)
+        {
+            const vector<size_t>& nodeElements = _nodes[node].elements;
+            matches.insert(matches.end(), nodeElements.begin(), nodeElements.end());
+            if (!nextToken(geom, GEOM_PATH_SEPARATOR, compPos, compBegin, pos))
+            {
+                break;
+            }
+            component.assign(geom, compBegin, compPos - compBegin);
+            auto it = _nodes[node].children.find(component);
+            if (it == _nodes[node].children.end())
+            {
+                foundNode = false;
+                break;
+            }
+            node = it->second;
+        }
+
+        // Indexed paths that the queried path contains lie beneath it.
+        if (foundNode)
+        {
+            nodeStack.clear();
+            for (const auto& child : _nodes[node].children)
+            {
+                nodeStack.push_back(child.second);
+            }
+            while (!nodeStack.empty())
+            {
+                const PathNode& pathNode = _nodes[nodeStack.back()];
+                nodeStack.pop_back();
+                matches.insert(matches.end(), pathNode.elements.begin(), pathNode.elements.end());
+                for (const auto& child : pathNode.children)
+                {
+                    nodeStack.push_back(child.second);
+                }
+            }
+        }
+    }
+
+    // Collections are evaluated only for elements that have not yet matched
+    // by their geometry strings.
+    if (!_collectionElements.empty())
+    {
+        std::sort(matches.begin(), matches.end());
+        size_t geomMatchCount = matches.size();
+        for (const auto& collectionElement : _collectionElements)
+        {
+            if (!std::binary_search(matches.begin(), matches.begin() + geomMatchCount, collectionElement.first) &&
+                collectionElement.second->matchesGeomString(geom))
+            {
+                matches.push_back(collectionElement.first);
+            }
+        }
+    }
+
+    // Return matches in the order in which elements were added.
+    std::sort(matches.begin(), matches.end());
+    matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+}
+
 //
 // GeomElement methods
 //
@@ -124,51 +368,146 @@ vector<CollectionPtr> Collection::getIncludeCollections() const
     return vec;
 }
 
+struct Collection::Matcher
+{
+    // The collection generation of the document, and the content hash of
+    // this collection and of each collection in its include closure, at the
+    // time the matcher was compiled.
+    size_t generation;
+    vector<std::pair<const Collection*, size_t>> contentHashes;
+
+    string excludeGeom;
+    string includeGeom;
+    bool hasCycle;
+
+    // The active include and exclude geometry strings of each collection in
+    // the include closure.
+    vector<std::pair<string, string>> includedGeoms;
+};
+
 bool Collection::hasIncludeCycle() const
 {
-    try
+    return getMatcher()->hasCycle;
+}
+
+bool Collection::matchesGeomString(const string& geom) const
+{
+    return evaluateMatcher(*getMatcher(), geom);
+}
+
+vector<bool> Collection::matchesGeomStrings(const StringVec& geoms, unsigned int threadCount) const
+{
+    shared_ptr<const Matcher> matcher = getMatcher();
+    vector<char> matches(geoms.size(), false);
+    forEachIndex(geoms.size(), threadCount, [this, &matcher, &geoms, &matches](size_t i)
+    {
+        matches[i] = evaluateMatcher(*matcher, geoms[i]);
+    });
+    return vector<bool>(matches.begin(), matches.end());
+}
+
+shared_ptr<const Collection::Matcher> Collection::getMatcher() const
+{
+    // Included collections are resolved by name from the root, so the
+    // compiled matcher remains valid while no collection has been added,
+    // removed or renamed, and the content of each collection in the include
+    // closure is unchanged.
+    ConstDocumentPtr doc = getDocument();
+    size_t generation = doc ? doc->getCollectionGeneration() : 0;
+    shared_ptr<const Matcher> matcher = std::atomic_load(&_matcher);
+    if (matcher && matcher->generation == generation)
+    {
+        bool unchanged = true;
+        for (const auto& contentHash : matcher->contentHashes)
+        {
+            if (contentHash.first->getContentHash() != contentHash.second)
+            {
+                unchanged = false;
+                break;
+            }
+        }
+        if (unchanged)
+        {
+            return matcher;
+        }
+    }
+
+    shared_ptr<Matcher> newMatcher = std::make_shared<Matcher>();
+    newMatcher->generation = generation;
+    newMatcher->contentHashes.emplace_back(this, getContentHash());
+    newMatcher->excludeGeom = getActiveExcludeGeom();
+    newMatcher->includeGeom = getActiveIncludeGeom();
+    newMatcher->hasCycle = false;
+
+    // Flatten the include closure, checking each include path for a cycle
+    // through a depth-first traversal.
+    struct IncludeFrame
+    {
+        const Collection* collection;
+        vector<CollectionPtr> includes;
+        size_t nextInclude;
+    };
+    vector<IncludeFrame> frames = { { this, getIncludeCollections(), 0 } };
+    std::set<const Collection*> visited = { this };
+    std::set<const Collection*> onPath = { this };
+    vector<CollectionPtr> closure;
+    while (!frames.empty())
     {
-        matchesGeomString(UNIVERSAL_GEOM_NAME);
+        IncludeFrame& frame = frames.back();
+        if (frame.nextInclude == frame.includes.size())
+        {
+            onPath.erase(frame.collection);
+            frames.pop_back();
+            continue;
+        }
+        CollectionPtr collection = frame.includes[frame.nextInclude++];
+        if (onPath.count(collection.get()))
+        {
+            newMatcher->hasCycle = true;
+        }
+        else if (visited.insert(collection.get()).second)
+        {
+            closure.push_back(collection);
+            onPath.insert(collection.get());
+            frames.push_back({ collection.get(), collection->getIncludeCollections(), 0 });
+        }
     }
-    catch (ExceptionFoundCycle&)
+    for (CollectionPtr collection : closure)
     {
-        return true;
+        newMatcher->contentHashes.emplace_back(collection.get(), collection->getContentHash());
+        newMatcher->includedGeoms.emplace_back(collection->getActiveIncludeGeom(),
+                                               collection->getActiveExcludeGeom());
     }
-    return false;
+
+    std::atomic_store(&_matcher, shared_ptr<const Matcher>(newMatcher));
+    return newMatcher;
 }
 
-bool Collection::matchesGeomString(const string& geom) const
+bool Collection::evaluateMatcher(const Matcher& matcher, const string& geom) const
 {
-    if (geomStringsMatch(getActiveExcludeGeom(), geom, true))
+    if (geomStringsMatch(matcher.excludeGeom, geom, true))
     {
         return false;
     }
-    if (geomStringsMatch(getActiveIncludeGeom(), geom))
+    if (geomStringsMatch(matcher.includeGeom, geom))
     {
         return true;
     }
-
-    std::set<CollectionPtr> includedSet;
-    vector<CollectionPtr> includedVec = getIncludeCollections();
-    for (size_t i = 0; i < includedVec.size(); i++)
+    if (matcher.hasCycle)
     {
-        CollectionPtr collection = includedVec[i];
-        if (includedSet.count(collection))
-        {
-            throw ExceptionFoundCycle("Encountered a cycle in collection: " + getName());
-        }
-        includedSet.insert(collection);
-        vector<CollectionPtr> appendVec = collection->getIncludeCollections();
-        includedVec.insert(includedVec.end(), appendVec.begin(), appendVec.end());
+        throw ExceptionFoundCycle("Encountered a cycle in collection: " + getName());
     }
-    for (ConstCollectionPtr collection : includedSet)
+
+    // Exclusions of an included collection apply only to its own include
+    // geometry, since the collections that it includes are tested directly.
+    for (const auto& includedGeom : matcher.includedGeoms)
     {
-        if (collection->matchesGeomString(geom))
+        if (!geomStringsMatch(includedGeom.second, geom, true) &&
+            geomStringsMatch(includedGeom.first, geom))
         {
             return true;
         }
     }
-
     return false;
 }
 
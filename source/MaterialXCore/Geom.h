@@ -28,6 +28,7 @@ class GeomPropDef;
 class Collection;
 class CollectionAdd;
 class CollectionRemove;
+class GeomPathIndex;
 
 /// A shared pointer to a GeomElement
 using GeomElementPtr = shared_ptr<GeomElement>;
@@ -54,6 +55,11 @@ using CollectionPtr = shared_ptr<Collection>;
 /// A shared pointer to a const Collection
 using ConstCollectionPtr = shared_ptr<const Collection>;
 
+/// A shared pointer to a GeomPathIndex
+using GeomPathIndexPtr = shared_ptr<GeomPathIndex>;
+/// A shared pointer to a const GeomPathIndex
+using ConstGeomPathIndexPtr = shared_ptr<const GeomPathIndex>;
+
 /// @class GeomPath
 /// A MaterialX geometry path, representing the hierarchical location
 /// expressed by a geometry name.
@@ -582,6 +588,14 @@ class Collection : public Element
     /// @throws ExceptionFoundCycle if a cycle is encountered.
     bool matchesGeomString(const string& geom) const;
 
+    /// Return a vector of results from matchesGeomString for each geometry
+    /// string in the given vector.
+    /// @param geoms The geometry strings to be tested.
+    /// @param threadCount The number of threads across which tests may be
+    ///    distributed, where zero selects the hardware concurrency.
+    /// @throws ExceptionFoundCycle if a cycle is encountered.
+    vector<bool> matchesGeomStrings(const StringVec& geoms, unsigned int threadCount = 1) const;
+
     /// @}
     /// @name Validation
     /// @{
@@ -597,6 +611,20 @@ class Collection : public Element
     static const string INCLUDE_GEOM_ATTRIBUTE;
     static const string EXCLUDE_GEOM_ATTRIBUTE;
     static const string INCLUDE_COLLECTION_ATTRIBUTE;
+
+  private:
+    struct Matcher;
+
+    // Return the compiled matcher for this collection, rebuilding it if any
+    // collection in its include closure has changed.
+    shared_ptr<const Matcher> getMatcher() const;
+
+    // Return true if the given matcher and geometry string have any
+    // geometries in common.
+    bool evaluateMatcher(const Matcher& matcher, const string& geom) const;
+
+  private:
+    mutable shared_ptr<const Matcher> _matcher;
 };
 
 template<class T> GeomAttrPtr GeomInfo::setGeomAttrValue(const string& name,
@@ -610,6 +638,66 @@ template<class T> GeomAttrPtr GeomInfo::setGeomAttrValue(const string& name,
     return geomAttr;
 }
 
+/// @class GeomPathIndex
+/// A compiled index of the geometry strings of a set of elements, supporting
+/// efficient queries for the elements whose geometry matches a given path.
+///
+/// Indexed geometry paths are stored in a trie of path components, so that a
+/// query visits each component of the queried path once, followed by any
+/// indexed paths that lie beneath it.  Elements that are bound to a collection
+/// are tested against their collection at query time.
+///
+/// An index is a snapshot of the geometry strings that were added to it, and
+/// is not updated when the indexed elements are later edited.
+class GeomPathIndex
+{
+  public:
+    GeomPathIndex();
+    ~GeomPathIndex() { }
+
+    /// Add an element to the index.
+    /// @param elem The element to be returned from matching queries.
+    /// @param geom The geometry string of the element, containing an array of
+    ///    geom names.
+    /// @param collection An optional collection to which the element is bound.
+    void addElement(ElementPtr elem, const string& geom, ConstCollectionPtr collection = nullptr);
+
+    /// Return the number of elements in the index.
+    size_t getElementCount() const
+    {
+        return _elements.size();
+    }
+
+    /// Return all indexed elements whose geometry string matches the given
+    /// geometry string, as defined by geomStringsMatch, or whose collection
+    /// matches the given geometry string.  Elements are returned in the order
+    /// in which they were added to the index.
+    /// @throws ExceptionFoundCycle if a cycle is encountered in a collection.
+    vector<ElementPtr> getMatchingElements(const string& geom) const;
+
+    /// Return the matching elements for each geometry string in the given
+    /// vector, as defined by getMatchingElements.
+    /// @param geoms The geometry strings to be queried.
+    /// @param threadCount The number of threads across which queries may be
+    ///    distributed, where zero selects the hardware concurrency.
+    /// @throws ExceptionFoundCycle if a cycle is encountered in a collection.
+    vector<vector<ElementPtr>> getMatchingElements(const StringVec& geoms, unsigned int threadCount = 1) const;
+
+  private:
+    struct PathNode
+    {
+        std::unordered_map<string, size_t> children;
+        vector<size_t> elements;
+    };
+
+    void addMatches(const string& geom, vector<size_t>& matches) const;
+
+  private:
+    vector<PathNode> _nodes;
+    vector<ElementPtr> _elements;
+    vector<std::pair<size_t, ConstCollectionPtr>> _collectionElements;
+};
+
 /// Given two geometry strings, each containing an array of geom names, return
 /// true if they have any geometries in common.
 ///
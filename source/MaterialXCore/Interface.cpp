@@ -43,6 +43,36 @@ const std::unordered_map<string, size_t> PortElement::CHANNELS_PATTERN_LENGTH =
     { "vector4", 4 }
 };
 
+namespace {
+
+// Return the element with the given name from a map of active elements, or an
+// empty shared pointer if no such element is present.
+template <class T> shared_ptr<T> findActiveElement(const std::unordered_map<string, shared_ptr<T>>& map, const string& name)
+{
+    auto it = map.find(name);
+    return it != map.end() ? it->second : shared_ptr<T>();
+}
+
+} // anonymous namespace
+
+// The flattened view of the value elements of an interface and its inherited
+// interfaces.  Vectors follow the order of traverseInheritance, and each map
+// holds the first element of its type with a given name.
+struct InterfaceElement::ActiveElements
+{
+    vector<std::pair<weak_ptr<const Element>, size_t>> chain;
+    vector<ParameterPtr> parameters;
+    vector<InputPtr> inputs;
+    vector<OutputPtr> outputs;
+    vector<TokenPtr> tokens;
+    vector<ValueElementPtr> valueElements;
+    std::unordered_map<string, ParameterPtr> parameterMap;
+    std::unordered_map<string, InputPtr> inputMap;
+    std::unordered_map<string, OutputPtr> outputMap;
+    std::unordered_map<string, TokenPtr> tokenMap;
+    std::unordered_map<string, ValueElementPtr> valueElementMap;
+};
+
 //
 // PortElement methods
 //
@@ -258,6 +288,14 @@ Edge Output::getUpstreamEdge(ConstMaterialPtr material, size_t index) const
 
 bool Output::hasUpstreamCycle() const
 {
+    // Outputs of a graph share the cycle detection pass of their graph.
+    ConstElementPtr parent = getParent();
+    ConstGraphElementPtr graph = parent ? parent->asA<GraphElement>() : nullptr;
+    if (graph)
+    {
+        return graph->hasUpstreamCycle(getSelf());
+    }
+
     try
     {
         for (Edge edge : traverseGraph()) { }
@@ -282,122 +320,119 @@ bool Output::validate(string* message) const
 
 ParameterPtr InterfaceElement::getActiveParameter(const string& name) const
 {
-    for (ConstElementPtr elem : traverseInheritance())
-    {
-        ParameterPtr param = elem->asA<InterfaceElement>()->getParameter(name);
-        if (param)
-        {
-            return param;
-        }
-    }
-    return nullptr;
+    return findActiveElement(getActiveElements()->parameterMap, name);
 }
 
 vector<ParameterPtr> InterfaceElement::getActiveParameters() const
 {
-    vector<ParameterPtr> activeParams;
-    for (ConstElementPtr elem : traverseInheritance())
-    {
-        vector<ParameterPtr> params = elem->asA<InterfaceElement>()->getParameters();
-        activeParams.insert(activeParams.end(), params.begin(), params.end());
-    }
-    return activeParams;
+    return getActiveElements()->parameters;
 }
 
 InputPtr InterfaceElement::getActiveInput(const string& name) const
 {
-    for (ConstElementPtr elem : traverseInheritance())
-    {
-        InputPtr input = elem->asA<InterfaceElement>()->getInput(name);
-        if (input)
-        {
-            return input;
-        }
-    }
-    return nullptr;
+    return findActiveElement(getActiveElements()->inputMap, name);
 }
 
 vector<InputPtr> InterfaceElement::getActiveInputs() const
 {
-    vector<InputPtr> activeInputs;
-    for (ConstElementPtr elem : traverseInheritance())
-    {
-        vector<InputPtr> inputs = elem->asA<InterfaceElement>()->getInputs();
-        activeInputs.insert(activeInputs.end(), inputs.begin(), inputs.end());
-    }
-    return activeInputs;
+    return getActiveElements()->inputs;
 }
 
 OutputPtr InterfaceElement::getActiveOutput(const string& name) const
 {
-    for (ConstElementPtr elem : traverseInheritance())
-    {
-        OutputPtr output = elem->asA<InterfaceElement>()->getOutput(name);
-        if (output)
-        {
-            return output;
-        }
-    }
-    return nullptr;
+    return findActiveElement(getActiveElements()->outputMap, name);
 }
 
 vector<OutputPtr> InterfaceElement::getActiveOutputs() const
 {
-    vector<OutputPtr> activeOutputs;
-    for (ConstElementPtr elem : traverseInheritance())
-    {
-        vector<OutputPtr> outputs = elem->asA<InterfaceElement>()->getOutputs();
-        activeOutputs.insert(activeOutputs.end(), outputs.begin(), outputs.end());
-    }
-    return activeOutputs;
+    return getActiveElements()->outputs;
 }
 
 TokenPtr InterfaceElement::getActiveToken(const string& name) const
 {
-    for (ConstElementPtr elem : traverseInheritance())
-    {
-        TokenPtr token = elem->asA<InterfaceElement>()->getToken(name);
-        if (token)
-        {
-            return token;
-        }
-    }
-    return nullptr;
+    return findActiveElement(getActiveElements()->tokenMap, name);
 }
 
 vector<TokenPtr> InterfaceElement::getActiveTokens() const
 {
-    vector<TokenPtr> activeTokens;
-    for (ConstElementPtr elem : traverseInheritance())
-    {
-        vector<TokenPtr> tokens = elem->asA<InterfaceElement>()->getTokens();
-        activeTokens.insert(activeTokens.end(), tokens.begin(), tokens.end());
-    }
-    return activeTokens;
+    return getActiveElements()->tokens;
 }
 
 ValueElementPtr InterfaceElement::getActiveValueElement(const string& name) const
 {
-    for (ConstElementPtr interface : traverseInheritance())
-    {
-        ValueElementPtr valueElem = interface->getChildOfType<ValueElement>(name);
-        if (valueElem)
-        {
-            return valueElem;
-        }
-    }
-    return nullptr;
+    return findActiveElement(getActiveElements()->valueElementMap, name);
 }
 
 vector<ValueElementPtr> InterfaceElement::getActiveValueElements() const
 {
-    vector<ValueElementPtr> activeValueElems;
-    for (ConstElementPtr interface : traverseInheritance())
+    return getActiveElements()->valueElements;
+}
+
+shared_ptr<const InterfaceElement::ActiveElements> InterfaceElement::getActiveElements() const
+{
+    // The cached view remains valid while the inheritance chain resolves to
+    // the same elements, and no child of any element in the chain has been
+    // added, removed, renamed or reordered.  Inheritance references are only
+    // resolved for elements with an inheritance string.
+    shared_ptr<const ActiveElements> active = std::atomic_load(&_activeElements);
+    if (active)
+    {
+        bool valid = true;
+        ConstElementPtr elem = getSelf();
+        for (const auto& link : active->chain)
+        {
+            if (!elem || elem != link.first.lock() || elem->_structureGeneration != link.second)
+            {
+                valid = false;
+                break;
+            }
+            elem = elem->hasInheritString() ? elem->getInheritsFrom() : nullptr;
+        }
+        valid = valid && !elem;
+        if (valid)
+        {
+            return active;
+        }
+    }
+
+    shared_ptr<ActiveElements> newActive = std::make_shared<ActiveElements>();
+    for (ConstElementPtr elem : traverseInheritance())
     {
-        vector<ValueElementPtr> valueElems = interface->getChildrenOfType<ValueElement>();
-        activeValueElems.insert(activeValueElems.end(), valueElems.begin(), valueElems.end());
+        newActive->chain.emplace_back(elem, elem->_structureGeneration);
+        for (const ElementPtr& child : elem->getChildren())
+        {
+            ValueElementPtr valueElem = child->asA<ValueElement>();
+            if (!valueElem)
+            {
+                continue;
+            }
+            newActive->valueElements.push_back(valueElem);
+            newActive->valueElementMap.emplace(valueElem->getName(), valueElem);
+            if (ParameterPtr param = child->asA<Parameter>())
+            {
+                newActive->parameters.push_back(param);
+                newActive->parameterMap.emplace(param->getName(), param);
+            }
+            else if (InputPtr input = child->asA<Input>())
+            {
+                newActive->inputs.push_back(input);
+                newActive->inputMap.emplace(input->getName(), input);
+            }
+            else if (OutputPtr output = child->asA<Output>())
+            {
+                newActive->outputs.push_back(output);
+                newActive->outputMap.emplace(output->getName(), output);
+            }
+            else if (TokenPtr token = child->asA<Token>())
+            {
+                newActive->tokens.push_back(token);
+                newActive->tokenMap.emplace(token->getName(), token);
+            }
+        }
     }
-    return activeValueElems;
+    active = newActive;
+    std::atomic_store(&_activeElements, active);
+    return active;
 }
 
 ValuePtr InterfaceElement::getParameterValue(const string& name, const string& target) const
@@ -489,7 +524,8 @@ bool InterfaceElement::isTypeCompatible(ConstInterfaceElementPtr declaration) co
     {
         return false;
     }
-    for (ValueElementPtr value : getActiveValueElements())
+    shared_ptr<const ActiveElements> active = getActiveElements();
+    for (const ValueElementPtr& value : active->valueElements)
     {
         ValueElementPtr declarationValue = declaration->getActiveValueElement(value->getName());
         if (!declarationValue ||
@@ -657,10 +657,19 @@ class InterfaceElement : public TypedElement
     void registerChildElement(ElementPtr child) override;
     void unregisterChildElement(ElementPtr child) override;
 
+  private:
+    struct ActiveElements;
+
+    // Return the flattened view of the value elements that belong to this
+    // interface, rebuilding it if this element or any element in its
+    // inheritance chain has changed.
+    shared_ptr<const ActiveElements> getActiveElements() const;
+
   private:
     size_t _parameterCount;
     size_t _inputCount;
     size_t _outputCount;
+    mutable shared_ptr<const ActiveElements> _activeElements;
 };
 
 template<class T> ParameterPtr InterfaceElement::setParameterValue(const string& name,
@@ -5,6 +5,8 @@
 
 #include <MaterialXCore/Look.h>
 
+#include <MaterialXCore/Document.h>
+
 namespace MaterialX
 {
 
@@ -109,4 +111,148 @@ MaterialPtr MaterialAssign::getReferencedMaterial() const
     return resolveRootNameReference<Material>(getMaterial());   
 }
 
+//
+// LookAssignments methods
+//
+
+bool LookAssignments::isVisible(const string& viewerGeom, const string& visibilityType) const
+{
+    for (const ResolvedVisibility& resolved : resolvedVisibilities)
+    {
+        if (!resolved.visibilityType.empty() && resolved.visibilityType != visibilityType)
+        {
+            continue;
+        }
+        bool allViewers = resolved.viewerGeom.empty() && !resolved.viewerCollection;
+        if (!allViewers)
+        {
+            if (viewerGeom.empty())
+            {
+                continue;
+            }
+            if (!geomStringsMatch(resolved.viewerGeom, viewerGeom) &&
+                !(resolved.viewerCollection && resolved.viewerCollection->matchesGeomString(viewerGeom)))
+            {
+                continue;
+            }
+        }
+        return resolved.visible;
+    }
+    return true;
+}
+
+//
+// LookResolver methods
+//
+
+LookResolver::LookResolver(ConstLookPtr look) :
+    _look(look)
+{
+    // Material assignments are indexed first, so that they precede all other
+    // assignments in the results of each query.
+    vector<VariantAssignPtr> lookVariantAssigns = look->getActiveVariantAssigns();
+    for (MaterialAssignPtr matAssign : look->getActiveMaterialAssigns())
+    {
+        _index.addElement(matAssign, matAssign->getActiveGeom(), matAssign->getCollection());
+        MaterialAssignInfo& info = _materialAssignInfo[matAssign.get()];
+        info.material = matAssign->getReferencedMaterial();
+        info.exclusive = matAssign->getExclusive();
+        info.variantAssigns = matAssign->getActiveVariantAssigns();
+        info.variantAssigns.insert(info.variantAssigns.end(), lookVariantAssigns.begin(), lookVariantAssigns.end());
+    }
+    for (PropertyAssignPtr propertyAssign : look->getActivePropertyAssigns())
+    {
+        _index.addElement(propertyAssign, propertyAssign->getGeom(), propertyAssign->getCollection());
+    }
+    for (PropertySetAssignPtr propertySetAssign : look->getActivePropertySetAssigns())
+    {
+        _index.addElement(propertySetAssign, propertySetAssign->getActiveGeom(), propertySetAssign->getCollection());
+    }
+    for (VisibilityPtr visibility : look->getActiveVisibilities())
+    {
+        _index.addElement(visibility, visibility->getActiveGeom(), visibility->getCollection());
+        ResolvedVisibility& info = _visibilityInfo[visibility.get()];
+        info.visibilityType = visibility->getVisibilityType();
+        info.viewerGeom = visibility->getViewerGeom();
+        if (visibility->hasViewerCollection())
+        {
+            info.viewerCollection = visibility->getDocument()->getCollection(visibility->getViewerCollection());
+        }
+        info.visible = visibility->getVisible();
+        info.visibility = visibility;
+    }
+}
+
+LookAssignments LookResolver::resolve(const string& geom) const
+{
+    return createAssignments(_index.getMatchingElements(geom));
+}
+
+vector<LookAssignments> LookResolver::resolve(const StringVec& geoms, unsigned int threadCount) const
+{
+    vector<vector<ElementPtr>> matches = _index.getMatchingElements(geoms, threadCount);
+    vector<LookAssignments> assignments;
+    assignments.reserve(matches.size());
+    for (const vector<ElementPtr>& geomMatches : matches)
+    {
+        assignments.push_back(createAssignments(geomMatches));
+    }
+    return assignments;
+}
+
+LookAssignments LookResolver::createAssignments(const vector<ElementPtr>& matches) const
+{
+    LookAssignments assignments;
+    bool foundExclusive = false;
+    for (const ElementPtr& elem : matches)
+    {
+        if (MaterialAssignPtr matAssign = elem->asA<MaterialAssign>())
+        {
+            if (foundExclusive)
+            {
+                continue;
+            }
+            const MaterialAssignInfo& info = _materialAssignInfo.at(matAssign.get());
+            if (assignments.materialAssigns.empty())
+            {
+                assignments.material = info.material;
+                assignments.variantAssigns = info.variantAssigns;
+            }
+            assignments.materialAssigns.push_back(matAssign);
+            foundExclusive = info.exclusive;
+        }
+        else if (PropertyAssignPtr propertyAssign = elem->asA<PropertyAssign>())
+        {
+            assignments.propertyAssigns.push_back(propertyAssign);
+        }
+        else if (PropertySetAssignPtr propertySetAssign = elem->asA<PropertySetAssign>())
+        {
+            assignments.propertySetAssigns.push_back(propertySetAssign);
+        }
+        else if (VisibilityPtr visibility = elem->asA<Visibility>())
+        {
+            // Lower-precedence visibilities for the same type and viewers
+            // are hidden by the first match.
+            assignments.visibilities.push_back(visibility);
+            const ResolvedVisibility& info = _visibilityInfo.at(visibility.get());
+            bool hidden = false;
+            for (const ResolvedVisibility& resolved : assignments.resolvedVisibilities)
+            {
+                if (resolved.visibilityType == info.visibilityType &&
+                    resolved.viewerGeom == info.viewerGeom &&
+                    resolved.viewerCollection == info.viewerCollection)
+                {
+                    hidden = true;
+                    break;
+                }
+            }
+            if (!hidden)
+            {
+                assignments.resolvedVisibilities.push_back(info);
+            }
+        }
+    }
+    return assignments;
+}
+
 } // namespace MaterialX
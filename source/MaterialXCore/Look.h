@@ -22,6 +22,7 @@ class Look;
 class LookInherit;
 class MaterialAssign;
 class Visibility;
+class LookResolver;
 
 /// A shared pointer to a Look
 using LookPtr = shared_ptr<Look>;
@@ -38,6 +39,9 @@ using VisibilityPtr = shared_ptr<Visibility>;
 /// A shared pointer to a const Visibility
 using ConstVisibilityPtr = shared_ptr<const Visibility>;
 
+/// A shared pointer to a LookResolver
+using LookResolverPtr = shared_ptr<LookResolver>;
+
 /// @class Look
 /// A look element within a Document.
 class Look : public Element
@@ -439,6 +443,146 @@ class Visibility : public GeomElement
     static const string VISIBLE_ATTRIBUTE;
 };
 
+/// @class ResolvedVisibility
+/// The visibility of a geometry for a single visibility type and set of
+/// viewers, as resolved from the Visibility elements of a look.
+class ResolvedVisibility
+{
+  public:
+    ResolvedVisibility() :
+        visible(false)
+    {
+    }
+    ~ResolvedVisibility() { }
+
+    /// The visibility type, or an empty string if the visibility applies to
+    /// all visibility types.
+    string visibilityType;
+
+    /// The viewer geometry string, containing an array of geom names.
+    string viewerGeom;
+
+    /// The viewer collection, if any.
+    CollectionPtr viewerCollection;
+
+    /// True if the geometry is visible to the given viewers.
+    bool visible;
+
+    /// The Visibility element from which this visibility was resolved.
+    VisibilityPtr visibility;
+};
+
+/// @class LookAssignments
+/// The assignments of a look that apply to a single geometry, as computed
+/// by a LookResolver.
+class LookAssignments
+{
+  public:
+    LookAssignments() { }
+    ~LookAssignments() { }
+
+    /// The material bound to the geometry, or an empty shared pointer if no
+    /// material is bound.
+    MaterialPtr material;
+
+    /// The MaterialAssign elements that match the geometry, in order of
+    /// precedence.  The first element binds the material, and no elements
+    /// follow a matching assignment that is exclusive.
+    vector<MaterialAssignPtr> materialAssigns;
+
+    /// The active VariantAssign elements for the bound material, with those
+    /// of its MaterialAssign preceding those of the look.
+    vector<VariantAssignPtr> variantAssigns;
+
+    /// The PropertyAssign elements that match the geometry.
+    vector<PropertyAssignPtr> propertyAssigns;
+
+    /// The PropertySetAssign elements that match the geometry.
+    vector<PropertySetAssignPtr> propertySetAssigns;
+
+    /// The Visibility elements that match the geometry.
+    vector<VisibilityPtr> visibilities;
+
+    /// The resolved visibility of the geometry, in order of precedence, with
+    /// one entry for each distinct combination of visibility type and viewers
+    /// among the matching Visibility elements.  Each entry is taken from the
+    /// highest-precedence element for its combination.
+    vector<ResolvedVisibility> resolvedVisibilities;
+
+    /// Return true if the geometry is visible to the given viewer for the
+    /// given visibility type.  The highest-precedence resolved visibility that
+    /// applies to the viewer and type is used, where a visibility with no
+    /// viewer geometry or collection applies to all viewers, and a visibility
+    /// with no type applies to all types.  Geometry with no applicable
+    /// visibility is visible.
+    /// @param viewerGeom The geometry name of the viewer, or an empty string
+    ///    to consider only visibilities that apply to all viewers.
+    /// @param visibilityType The visibility type, or an empty string to
+    ///    consider only visibilities that apply to all types.
+    /// @throws ExceptionFoundCycle if a cycle is encountered in a viewer
+    ///    collection.
+    bool isVisible(const string& viewerGeom = EMPTY_STRING, const string& visibilityType = EMPTY_STRING) const;
+};
+
+/// @class LookResolver
+/// A class for resolving the assignments of a look across many geometries.
+///
+/// A LookResolver gathers the active assignments of a look, taking look
+/// inheritance into account, and compiles their geometry strings into a
+/// GeomPathIndex, so that all assignments for a geometry are resolved in a
+/// single query.  The resolver compiles its own index rather than querying
+/// Document::getGeomPathIndex, whose index spans every look and geominfo in
+/// the document without regard to look inheritance, and is discarded on any
+/// edit to a look.  The resolver is a snapshot of the look at the time of its
+/// construction, and is not updated when the look is later edited.
+class LookResolver
+{
+  public:
+    explicit LookResolver(ConstLookPtr look);
+    ~LookResolver() { }
+
+    /// Create a new LookResolver for the given look.
+    static LookResolverPtr create(ConstLookPtr look)
+    {
+        return std::make_shared<LookResolver>(look);
+    }
+
+    /// Return the look for which assignments are resolved.
+    ConstLookPtr getLook() const
+    {
+        return _look;
+    }
+
+    /// Return the assignments of the look that apply to the given geometry
+    /// string.
+    /// @throws ExceptionFoundCycle if a cycle is encountered in a collection.
+    LookAssignments resolve(const string& geom) const;
+
+    /// Return the assignments of the look that apply to each geometry string
+    /// in the given vector.
+    /// @param geoms The geometry strings to be resolved.
+    /// @param threadCount The number of threads across which geometry queries
+    ///    may be distributed, where zero selects the hardware concurrency.
+    /// @throws ExceptionFoundCycle if a cycle is encountered in a collection.
+    vector<LookAssignments> resolve(const StringVec& geoms, unsigned int threadCount = 1) const;
+
+  private:
+    struct MaterialAssignInfo
+    {
+        MaterialPtr material;
+        bool exclusive;
+        vector<VariantAssignPtr> variantAssigns;
+    };
+
+    LookAssignments createAssignments(const vector<ElementPtr>& matches) const;
+
+  private:
+    ConstLookPtr _look;
+    GeomPathIndex _index;
+    std::unordered_map<const Element*, MaterialAssignInfo> _materialAssignInfo;
+    std::unordered_map<const Element*, ResolvedVisibility> _visibilityInfo;
+};
+
 } // namespace MaterialX
 
 #endif
@@ -9,10 +9,160 @@
 #include <MaterialXCore/Material.h>
 
 #include <deque>
+#include <limits>
+#include <unordered_set>
 
 namespace MaterialX
 {
 
+namespace {
+
+// Return the names of the children of the given graph from which a cycle is
+// reachable upstream.  Strongly connected components are found with an iterative form
+// of Tarjan's algorithm, which completes each component only after all
+// components upstream of it, allowing reachability to be propagated as
+// components are completed.
+//
+// Running time: O(numChildren + numEdges).
+std::unordered_set<string> findUpstreamCycles(const GraphElement& graph)
+{
+    const vector<ElementPtr>& children = graph.getChildren();
+    const size_t childCount = children.size();
+
+    // Gather the upstream edges between children of the graph.
+    std::unordered_map<const Element*, size_t> childIndexMap(childCount);
+    for (size_t i = 0; i < childCount; i++)
+    {
+        childIndexMap[children[i].get()] = i;
+    }
+    vector<vector<size_t>> upstream(childCount);
+    for (size_t i = 0; i < childCount; i++)
+    {
+        const ElementPtr& child = children[i];
+        for (size_t j = 0; j < child->getUpstreamEdgeCount(); j++)
+        {
+            ElementPtr upstreamElem = child->getUpstreamElement(nullptr, j);
+            auto it = upstreamElem ? childIndexMap.find(upstreamElem.get()) : childIndexMap.end();
+            if (it != childIndexMap.end())
+            {
+                upstream[i].push_back(it->second);
+            }
+        }
+    }
+
+    const size_t UNVISITED = std::numeric_limits<size_t>::max();
+    vector<size_t> visitOrder(childCount, UNVISITED);
+    vector<size_t> lowLink(childCount);
+    vector<size_t> component(childCount, UNVISITED);
+    vector<bool> onStack(childCount, false);
+    vector<size_t> componentStack;
+    vector<size_t> members;
+    vector<bool> componentReachesCycle;
+    vector<std::pair<size_t, size_t>> callStack;
+    size_t visitCount = 0;
+
+    for (size_t root = 0; root < childCount; root++)
+    {
+        if (visitOrder[root] != UNVISITED)
+        {
+            continue;
+        }
+        visitOrder[root] = lowLink[root] = visitCount++;
+        componentStack.push_back(root);
+        onStack[root] = true;
+        callStack.emplace_back(root, 0);
+
+        while (!callStack.empty())
+        {
+            // Visit the next upstream edge of the current child.
+            size_t v = callStack.back().first;
+            if (callStack.back().second < upstream[v].size())
+            {
+                size_t w = upstream[v][callStack.back().second++];
+                if (visitOrder[w] == UNVISITED)
+                {
+                    visitOrder[w] = lowLink[w] = visitCount++;
+                    componentStack.push_back(w);
+                    onStack[w] = true;
+                    callStack.emplace_back(w, 0);
+                }
+                else if (onStack[w])
+                {
+                    lowLink[v] = std::min(lowLink[v], visitOrder[w]);
+                }
+                continue;
+            }
+
+            // Return to the downstream child.
+            callStack.pop_back();
+            if (!callStack.empty())
+            {
+                size_t parent = callStack.back().first;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[v]);
+            }
+            if (lowLink[v] != visitOrder[v])
+            {
+                continue;
+            }
+
+            // Complete the component rooted at this child.
+            size_t index = componentReachesCycle.size();
+            members.clear();
+            size_t w;
+            do
+            {
+                w = componentStack.back();
+                componentStack.pop_back();
+                onStack[w] = false;
+                component[w] = index;
+                members.push_back(w);
+            } while (w != v);
+
+            // A component reaches a cycle if it contains one, either through
+            // multiple members or a self-connection, or if any component
+            // upstream of it does.
+            bool reachesCycle = members.size() > 1;
+            for (size_t member : members)
+            {
+                for (size_t up : upstream[member])
+                {
+                    if (component[up] == index ? up == member : componentReachesCycle[component[up]])
+                    {
+                        reachesCycle = true;
+                    }
+                }
+            }
+            componentReachesCycle.push_back(reachesCycle);
+        }
+    }
+
+    std::unordered_set<string> cycleNames;
+    for (size_t i = 0; i < childCount; i++)
+    {
+        if (componentReachesCycle[component[i]])
+        {
+            cycleNames.insert(children[i]->getName());
+        }
+    }
+    return cycleNames;
+}
+
+} // anonymous namespace
+
+struct GraphElement::CycleInfo
+{
+    size_t contentHash;
+    std::unordered_set<string> cycleNames;
+};
+
+struct Node::NodeDefMemo
+{
+    size_t contentHash;
+    size_t generation;
+    string target;
+    NodeDefPtr nodeDef;
+};
+
 //
 // Node methods
 //
@@ -72,19 +222,25 @@ NodeDefPtr Node::getNodeDef(const string& target) const
     {
         return resolveRootNameReference<NodeDef>(getNodeDefString());
     }
-    vector<NodeDefPtr> nodeDefs = getDocument()->getMatchingNodeDefs(getQualifiedName(getCategory()));
-    vector<NodeDefPtr> secondary = getDocument()->getMatchingNodeDefs(getCategory());
-    nodeDefs.insert(nodeDefs.end(), secondary.begin(), secondary.end());
-    for (NodeDefPtr nodeDef : nodeDefs)
+
+    // The memoized nodedef remains valid while the content of this node and
+    // of all nodedefs in the document is unchanged.
+    ConstDocumentPtr doc = getDocument();
+    size_t contentHash = getContentHash();
+    size_t generation = doc->getNodeDefGeneration();
+    shared_ptr<const NodeDefMemo> memo = std::atomic_load(&_nodeDefMemo);
+    if (memo && memo->contentHash == contentHash && memo->generation == generation && memo->target == target)
     {
-        if (targetStringsMatch(nodeDef->getTarget(), target) &&
-            nodeDef->isVersionCompatible(getSelf()) &&
-            isTypeCompatible(nodeDef))
-        {
-            return nodeDef;
-        }
+        return memo->nodeDef;
     }
-    return NodeDefPtr();
+
+    shared_ptr<NodeDefMemo> newMemo = std::make_shared<NodeDefMemo>();
+    newMemo->contentHash = contentHash;
+    newMemo->generation = generation;
+    newMemo->target = target;
+    newMemo->nodeDef = doc->getSignatureNodeDef(*this, target);
+    std::atomic_store(&_nodeDefMemo, shared_ptr<const NodeDefMemo>(newMemo));
+    return newMemo->nodeDef;
 }
 
 Edge Node::getUpstreamEdge(ConstMaterialPtr material, size_t index) const
@@ -119,15 +275,7 @@ OutputPtr Node::getNodeDefOutput(const Edge& edge)
 
 vector<PortElementPtr> Node::getDownstreamPorts() const
 {
-    vector<PortElementPtr> downstreamPorts;
-    for (PortElementPtr port : getDocument()->getMatchingPorts(getName()))
-    {
-        if (port->getConnectedNode() == getSelf())
-        {
-            downstreamPorts.push_back(port);
-        }
-    }
-    return downstreamPorts;
+    return getDocument()->getDownstreamPorts(*this);
 }
 
 bool Node::validate(string* message) const
@@ -252,6 +400,29 @@ void GraphElement::flattenSubgraphs(const string& target)
     }
 }
 
+bool GraphElement::hasUpstreamCycle(ConstElementPtr child) const
+{
+    // The cached result remains valid while the content hash of the graph
+    // is unchanged.  Children are recorded by name rather than by address,
+    // since a child may be replaced by an identical element without
+    // changing the hash.
+    if (!child || getChild(child->getName()) != child)
+    {
+        return false;
+    }
+    size_t contentHash = getContentHash();
+    shared_ptr<const CycleInfo> cycleInfo = std::atomic_load(&_cycleInfo);
+    if (!cycleInfo || cycleInfo->contentHash != contentHash)
+    {
+        shared_ptr<CycleInfo> newInfo = std::make_shared<CycleInfo>();
+        newInfo->contentHash = contentHash;
+        newInfo->cycleNames = findUpstreamCycles(*this);
+        cycleInfo = newInfo;
+        std::atomic_store(&_cycleInfo, cycleInfo);
+    }
+    return cycleInfo->cycleNames.count(child->getName()) != 0;
+}
+
 vector<ElementPtr> GraphElement::topologicalSort() const
 {
     // Calculate a topological order of the children, using Kahn's algorithm
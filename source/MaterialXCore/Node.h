@@ -149,6 +149,10 @@ class Node : public InterfaceElement
 
   public:
     static const string CATEGORY;
+
+  private:
+    struct NodeDefMemo;
+    mutable shared_ptr<const NodeDefMemo> _nodeDefMemo;
 };
 
 /// @class GraphElement
@@ -223,6 +227,12 @@ class GraphElement : public InterfaceElement
     /// @throws ExceptionFoundCycle if a cycle is encountered.
     vector<ElementPtr> topologicalSort() const;
 
+    /// Return true if a cycle is reachable upstream from the given child
+    /// element of this graph.  Cycles are found for all children in a single
+    /// linear-time pass over the graph, and the result is cached until the
+    /// contents of the graph change.
+    bool hasUpstreamCycle(ConstElementPtr child) const;
+
     /// Convert this graph to a string in the DOT language syntax.  This can be
     /// used to visualise the graph using GraphViz (http://www.graphviz.org).
     ///
@@ -232,6 +242,10 @@ class GraphElement : public InterfaceElement
     string asStringDot() const;
 
     /// @}
+
+  private:
+    struct CycleInfo;
+    mutable shared_ptr<const CycleInfo> _cycleInfo;
 };
 
 /// @class NodeGraph
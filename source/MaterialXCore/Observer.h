@@ -62,6 +62,10 @@ class Observer
     /// Called when data is written from the current document.
     virtual void onWrite() { }
 
+    /// Called when a bulk load of elements into the current document
+    /// has completed.
+    virtual void onBulkLoad() { }
+
     /// Called before a set of document updates is performed.
     virtual void onBeginUpdate() { }
 
@@ -140,6 +144,7 @@ class ObservedDocument : public Document
     DocumentPtr copy() const override
     {
         DocumentPtr doc = createDocument<ObservedDocument>();
+        doc->setElementArenaEnabled(getElementArena() != nullptr);
         doc->copyContentFrom(getSelf());
         return doc;
     }
@@ -195,6 +200,7 @@ class ObservedDocument : public Document
 
     void onCopyContent(ElementPtr elem) override
     {
+        Document::onCopyContent(elem);
         if (_callbacksEnabled)
         {
             for (auto& item : _observerMap)
@@ -206,6 +212,7 @@ class ObservedDocument : public Document
 
     void onClearContent(ElementPtr elem) override
     {
+        Document::onClearContent(elem);
         if (_callbacksEnabled)
         {
             for (auto& item : _observerMap)
@@ -237,6 +244,17 @@ class ObservedDocument : public Document
         }
     }
 
+    void onBulkLoad() override
+    {
+        if (_callbacksEnabled)
+        {
+            for (auto& item : _observerMap)
+            {
+                item.second->onBulkLoad();
+            }
+        }
+    }
+
     void onBeginUpdate() override
     {
         // Only send notification for the outermost scope.
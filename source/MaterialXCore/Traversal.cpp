@@ -7,11 +7,20 @@
 
 #include <MaterialXCore/Node.h>
 
+#include <algorithm>
+
 namespace MaterialX
 {
 
 const Edge NULL_EDGE(nullptr, nullptr, nullptr);
 
+namespace {
+
+// The initial table size for the set of elements along a traversal path.
+const size_t MIN_PATH_TABLE_SIZE = 32;
+
+} // anonymous namespace
+
 const TreeIterator NULL_TREE_ITERATOR(nullptr);
 const GraphIterator NULL_GRAPH_ITERATOR(nullptr, nullptr);
 const InheritanceIterator NULL_INHERITANCE_ITERATOR(nullptr);
@@ -83,12 +92,19 @@ TreeIterator& TreeIterator::operator++()
 // GraphIterator methods
 //
 
+ElementPtr GraphIterator::getDownstreamElement() const
+{
+    return !_stack.empty() ? _stack.back().first->getSelf() : ElementPtr();
+}
+
 size_t GraphIterator::getNodeDepth() const
 {
-    size_t nodeDepth = 0;
-    for (ElementPtr elem : _pathElems)
+    // The current path consists of the stacked elements and the current
+    // upstream element.
+    size_t nodeDepth = (_upstreamElem && _upstreamElem->isA<Node>()) ? 1 : 0;
+    for (const StackFrame& frame : _stack)
     {
-        if (elem->isA<Node>())
+        if (frame.first->isA<Node>())
         {
             nodeDepth++;
         }
@@ -112,7 +128,7 @@ GraphIterator& GraphIterator::operator++()
     if (!_prune && _upstreamElem && _upstreamElem->getUpstreamEdgeCount())
     {
         // Traverse to the first upstream edge of this element.
-        _stack.push_back(StackFrame(_upstreamElem, 0));
+        _stack.push_back(StackFrame(_upstreamElem.get(), 0));
         Edge nextEdge = _upstreamElem->getUpstreamEdge(_material, 0);
         if (nextEdge)
         {
@@ -126,7 +142,7 @@ GraphIterator& GraphIterator::operator++()
     {
         if (_upstreamElem)
         {
-            returnPathDownstream(_upstreamElem);
+            returnPathDownstream(_upstreamElem.get());
         }
 
         if (_stack.empty())
@@ -157,27 +173,114 @@ GraphIterator& GraphIterator::operator++()
     return *this;
 }
 
-void GraphIterator::extendPathUpstream(ElementPtr upstreamElem, ElementPtr connectingElem)
+void GraphIterator::extendPathUpstream(const ElementPtr& upstreamElem, const ElementPtr& connectingElem)
 {
-    // Check for cycles.
-    if (_pathElems.count(upstreamElem))
+    // Extend the current path to the new element, checking for cycles.
+    if (!_pathElems.insert(upstreamElem.get()))
     {
         throw ExceptionFoundCycle("Encountered cycle at element: " + upstreamElem->asString());
     }
-
-    // Extend the current path to the new element.
-    _pathElems.insert(upstreamElem);
     _upstreamElem = upstreamElem;
     _connectingElem = connectingElem;
 }
 
-void GraphIterator::returnPathDownstream(ElementPtr upstreamElem)
+void GraphIterator::returnPathDownstream(const Element* upstreamElem)
 {
     _pathElems.erase(upstreamElem);
     _upstreamElem = ElementPtr();
     _connectingElem = ElementPtr();
 }
 
+//
+// GraphIterator::PathSet methods
+//
+
+bool GraphIterator::PathSet::insert(const Element* elem)
+{
+    if ((_size + 1) * 2 > _table.size())
+    {
+        grow();
+    }
+
+    size_t mask = _table.size() - 1;
+    size_t slot = getHomeSlot(elem);
+    while (_table[slot])
+    {
+        if (_table[slot] == elem)
+        {
+            return false;
+        }
+        slot = (slot + 1) & mask;
+    }
+    _table[slot] = elem;
+    _size++;
+    return true;
+}
+
+void GraphIterator::PathSet::erase(const Element* elem)
+{
+    if (_table.empty())
+    {
+        return;
+    }
+
+    size_t mask = _table.size() - 1;
+    size_t slot = getHomeSlot(elem);
+    while (_table[slot] != elem)
+    {
+        if (!_table[slot])
+        {
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    _table[slot] = nullptr;
+    _size--;
+
+    // Shift later entries of the probe sequence back into the vacated slot,
+    // so that lookups never stop early at a gap.
+    size_t next = slot;
+    while (true)
+    {
+        next = (next + 1) & mask;
+        if (!_table[next])
+        {
+            break;
+        }
+        size_t home = getHomeSlot(_table[next]);
+        bool movable = (slot <= next) ? (home <= slot || home > next) : (home <= slot && home > next);
+        if (movable)
+        {
+            _table[slot] = _table[next];
+            _table[next] = nullptr;
+            slot = next;
+        }
+    }
+}
+
+size_t GraphIterator::PathSet::getHomeSlot(const Element* elem) const
+{
+    // Discard low-order bits that are shared by all aligned allocations.
+    size_t hash = reinterpret_cast<size_t>(elem) >> 4;
+    hash *= (size_t) 0x9e3779b97f4a7c15ull;
+    return (hash ^ (hash >> 29)) & (_table.size() - 1);
+}
+
+void GraphIterator::PathSet::grow()
+{
+    vector<const Element*> oldTable;
+    oldTable.swap(_table);
+    _table.assign(std::max(oldTable.size() * 2, MIN_PATH_TABLE_SIZE), nullptr);
+    _size = 0;
+    for (const Element* elem : oldTable)
+    {
+        if (elem)
+        {
+            insert(elem);
+        }
+    }
+}
+
 //
 // InheritanceIterator methods
 //
@@ -200,13 +200,40 @@ class GraphIterator
         _prune(false),
         _holdCount(0)
     {
-        _pathElems.insert(elem);
+        if (elem)
+        {
+            _pathElems.insert(elem.get());
+        }
     }
     ~GraphIterator() { }
 
   private:
-    using ElementSet = std::set<ElementPtr>;
-    using StackFrame = std::pair<ElementPtr, size_t>;
+    // A set of the elements along the current traversal path, held as raw
+    // pointers in an open-addressed table, so that extending and returning
+    // the path performs no allocation once the table fits the path.
+    class PathSet
+    {
+      public:
+        PathSet() : _size(0) { }
+
+        // Insert the given element, returning false if it was already present.
+        bool insert(const Element* elem);
+
+        // Erase the given element, if present.
+        void erase(const Element* elem);
+
+      private:
+        size_t getHomeSlot(const Element* elem) const;
+        void grow();
+
+      private:
+        vector<const Element*> _table;
+        size_t _size;
+    };
+
+    // Stack frames hold raw element pointers, as the graph is owned by its
+    // document and is not modified during traversal.
+    using StackFrame = std::pair<Element*, size_t>;
 
   public:
     bool operator==(const GraphIterator& rhs) const
@@ -237,10 +264,7 @@ class GraphIterator
     /// @{
 
     /// Return the downstream element of the current edge.
-    ElementPtr getDownstreamElement() const
-    {
-        return !_stack.empty() ? _stack.back().first : ElementPtr();
-    }
+    ElementPtr getDownstreamElement() const;
 
     /// Return the connecting element, if any, of the current edge.
     ElementPtr getConnectingElement() const
@@ -306,6 +330,7 @@ class GraphIterator
         // Increment once to generate a valid edge.
         if (_stack.empty())
         {
+            _stack.reserve(STACK_RESERVE_COUNT);
             operator++();
         }
 
@@ -319,13 +344,15 @@ class GraphIterator
     /// @}
 
   private:
-    void extendPathUpstream(ElementPtr upstreamElem, ElementPtr connectingElem);
-    void returnPathDownstream(ElementPtr upstreamElem);
+    void extendPathUpstream(const ElementPtr& upstreamElem, const ElementPtr& connectingElem);
+    void returnPathDownstream(const Element* upstreamElem);
 
   private:
+    static const size_t STACK_RESERVE_COUNT = 16;
+
     ElementPtr _upstreamElem;
     ElementPtr _connectingElem;
-    ElementSet _pathElems;
+    PathSet _pathElems;
     ConstMaterialPtr _material;
     vector<StackFrame> _stack;
     bool _prune;
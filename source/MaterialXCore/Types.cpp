@@ -5,11 +5,120 @@
 
 #include <MaterialXCore/Types.h>
 
+#include <algorithm>
 #include <cmath>
+#include <thread>
+
+#if !defined(MATERIALX_DISABLE_SIMD)
+    #if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+        #define MATERIALX_SIMD_SSE
+        #include <xmmintrin.h>
+    #elif defined(__ARM_NEON) && defined(__aarch64__)
+        #define MATERIALX_SIMD_NEON
+        #include <arm_neon.h>
+    #endif
+#endif
 
 namespace MaterialX
 {
 
+namespace {
+
+// Thin wrappers over the four-wide float instructions of the target, with a
+// scalar fallback that evaluates each lane in the same order.
+#if defined(MATERIALX_SIMD_SSE)
+using SimdFloat4 = __m128;
+inline SimdFloat4 simdLoad(const float* p) { return _mm_loadu_ps(p); }
+inline void simdStore(float* p, SimdFloat4 v) { _mm_storeu_ps(p, v); }
+inline SimdFloat4 simdSplat(float s) { return _mm_set1_ps(s); }
+inline SimdFloat4 simdAdd(SimdFloat4 a, SimdFloat4 b) { return _mm_add_ps(a, b); }
+inline SimdFloat4 simdMul(SimdFloat4 a, SimdFloat4 b) { return _mm_mul_ps(a, b); }
+#elif defined(MATERIALX_SIMD_NEON)
+using SimdFloat4 = float32x4_t;
+inline SimdFloat4 simdLoad(const float* p) { return vld1q_f32(p); }
+inline void simdStore(float* p, SimdFloat4 v) { vst1q_f32(p, v); }
+inline SimdFloat4 simdSplat(float s) { return vdupq_n_f32(s); }
+inline SimdFloat4 simdAdd(SimdFloat4 a, SimdFloat4 b) { return vaddq_f32(a, b); }
+inline SimdFloat4 simdMul(SimdFloat4 a, SimdFloat4 b) { return vmulq_f32(a, b); }
+#else
+struct SimdFloat4
+{
+    float v[4];
+};
+template <class F> SimdFloat4 simdApply(SimdFloat4 a, SimdFloat4 b, F func)
+{
+    return SimdFloat4{ { func(a.v[0], b.v[0]), func(a.v[1], b.v[1]), func(a.v[2], b.v[2]), func(a.v[3], b.v[3]) } };
+}
+inline SimdFloat4 simdLoad(const float* p) { return SimdFloat4{ { p[0], p[1], p[2], p[3] } }; }
+inline void simdStore(float* p, SimdFloat4 v) { std::copy(v.v, v.v + 4, p); }
+inline SimdFloat4 simdSplat(float s) { return SimdFloat4{ { s, s, s, s } }; }
+inline SimdFloat4 simdAdd(SimdFloat4 a, SimdFloat4 b) { return simdApply(a, b, [](float x, float y) { return x + y; }); }
+inline SimdFloat4 simdMul(SimdFloat4 a, SimdFloat4 b) { return simdApply(a, b, [](float x, float y) { return x * y; }); }
+#endif
+
+// The smallest number of elements worth handing to a worker thread.
+const size_t MIN_ELEMENTS_PER_THREAD = 16384;
+
+// Apply a function to consecutive ranges of [0, count), distributing the
+// ranges across up to threadCount threads.
+template <class F> void forEachRange(size_t count, unsigned int threadCount, F func)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    size_t rangeCount = std::min((size_t) threadCount, std::max(count / MIN_ELEMENTS_PER_THREAD, (size_t) 1));
+    if (rangeCount <= 1)
+    {
+        func(0, count);
+        return;
+    }
+
+    size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+    vector<std::thread> threads;
+    for (size_t begin = rangeSize; begin < count; begin += rangeSize)
+    {
+        threads.emplace_back(func, begin, std::min(begin + rangeSize, count));
+    }
+    func(0, rangeSize);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+// Transform an array of three-dimensional rows in place by the given matrix,
+// with w giving the implicit fourth component of each row.
+void transformRows(const Matrix44& m, float w, float* data, size_t count, size_t stride, unsigned int threadCount)
+{
+    if (stride < 3)
+    {
+        throw Exception("Invalid stride for transformed array: " + std::to_string(stride));
+    }
+
+    forEachRange(count, threadCount, [&m, w, data, stride](size_t begin, size_t end)
+    {
+        SimdFloat4 r0 = simdLoad(m[0].data());
+        SimdFloat4 r1 = simdLoad(m[1].data());
+        SimdFloat4 r2 = simdLoad(m[2].data());
+        SimdFloat4 r3 = simdMul(simdLoad(m[3].data()), simdSplat(w));
+        float res[4];
+        for (float* v = data + begin * stride; v != data + end * stride; v += stride)
+        {
+            SimdFloat4 acc = simdMul(simdSplat(v[0]), r0);
+            acc = simdAdd(acc, simdMul(simdSplat(v[1]), r1));
+            acc = simdAdd(acc, simdMul(simdSplat(v[2]), r2));
+            acc = simdAdd(acc, r3);
+            simdStore(res, acc);
+            v[0] = res[0];
+            v[1] = res[1];
+            v[2] = res[2];
+        }
+    });
+}
+
+} // anonymous namespace
+
 const string DEFAULT_TYPE_STRING = "color3";
 const string FILENAME_TYPE_STRING = "filename";
 const string GEOMNAME_TYPE_STRING = "geomname";
@@ -113,12 +222,56 @@ Matrix33 Matrix33::createRotation(float angle)
 // Matrix44 methods
 //
 
+template <> Matrix44 MatrixN<Matrix44, float, 4>::operator*(const Matrix44& rhs) const
+{
+    // Each row of the product is a linear combination of the rows of rhs,
+    // accumulated in the same order as the generic implementation.
+    SimdFloat4 r0 = simdLoad(rhs[0].data());
+    SimdFloat4 r1 = simdLoad(rhs[1].data());
+    SimdFloat4 r2 = simdLoad(rhs[2].data());
+    SimdFloat4 r3 = simdLoad(rhs[3].data());
+    Matrix44 res(Uninit{});
+    for (size_t i = 0; i < 4; i++)
+    {
+        const RowArray& row = _arr[i];
+        SimdFloat4 acc = simdMul(simdSplat(row[0]), r0);
+        acc = simdAdd(acc, simdMul(simdSplat(row[1]), r1));
+        acc = simdAdd(acc, simdMul(simdSplat(row[2]), r2));
+        acc = simdAdd(acc, simdMul(simdSplat(row[3]), r3));
+        simdStore(res[i].data(), acc);
+    }
+    return res;
+}
+
 template <> Matrix44 MatrixN<Matrix44, float, 4>::getTranspose() const
 {
+#if defined(MATERIALX_SIMD_SSE)
+    __m128 r0 = _mm_loadu_ps(_arr[0].data());
+    __m128 r1 = _mm_loadu_ps(_arr[1].data());
+    __m128 r2 = _mm_loadu_ps(_arr[2].data());
+    __m128 r3 = _mm_loadu_ps(_arr[3].data());
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    Matrix44 res(Uninit{});
+    _mm_storeu_ps(res[0].data(), r0);
+    _mm_storeu_ps(res[1].data(), r1);
+    _mm_storeu_ps(res[2].data(), r2);
+    _mm_storeu_ps(res[3].data(), r3);
+    return res;
+#elif defined(MATERIALX_SIMD_NEON)
+    // A de-interleaving load of the row-major data yields the columns.
+    float32x4x4_t cols = vld4q_f32(data());
+    Matrix44 res(Uninit{});
+    vst1q_f32(res[0].data(), cols.val[0]);
+    vst1q_f32(res[1].data(), cols.val[1]);
+    vst1q_f32(res[2].data(), cols.val[2]);
+    vst1q_f32(res[3].data(), cols.val[3]);
+    return res;
+#else
     return Matrix44(_arr[0][0], _arr[1][0], _arr[2][0], _arr[3][0],
                     _arr[0][1], _arr[1][1], _arr[2][1], _arr[3][1],
                     _arr[0][2], _arr[1][2], _arr[2][2], _arr[3][2],
                     _arr[0][3], _arr[1][3], _arr[2][3], _arr[3][3]);
+#endif
 }
 
 template <> float MatrixN<Matrix44, float, 4>::getDeterminant() const
@@ -185,6 +338,40 @@ template <> Matrix44 MatrixN<Matrix44, float, 4>::getAdjugate() const
         _arr[0][0]*_arr[2][1]*_arr[1][2] - _arr[1][0]*_arr[0][1]*_arr[2][2] - _arr[2][0]*_arr[1][1]*_arr[0][2]);
 }
 
+Vector3 Matrix44::transformPoint(const Vector3& v) const
+{
+    Vector3 res(v);
+    transformRows(*this, 1.0f, res.data(), 1, 3, 1);
+    return res;
+}
+
+Vector3 Matrix44::transformVector(const Vector3& v) const
+{
+    Vector3 res(v);
+    transformRows(*this, 0.0f, res.data(), 1, 3, 1);
+    return res;
+}
+
+Vector3 Matrix44::transformNormal(const Vector3& v) const
+{
+    return getInverse().getTranspose().transformVector(v);
+}
+
+void Matrix44::transformPoints(float* data, size_t count, size_t stride, unsigned int threadCount) const
+{
+    transformRows(*this, 1.0f, data, count, stride, threadCount);
+}
+
+void Matrix44::transformVectors(float* data, size_t count, size_t stride, unsigned int threadCount) const
+{
+    transformRows(*this, 0.0f, data, count, stride, threadCount);
+}
+
+void Matrix44::transformNormals(float* data, size_t count, size_t stride, unsigned int threadCount) const
+{
+    transformRows(getInverse().getTranspose(), 0.0f, data, count, stride, threadCount);
+}
+
 Matrix44 Matrix44::createTranslation(const Vector3& v)
 {
     return Matrix44(1.0f, 0.0f, 0.0f, 0.0f,
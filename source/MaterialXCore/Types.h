@@ -69,11 +69,13 @@ template <class V, class S, size_t N> class VectorN : public VectorBase
     /// @name Indexing Operators
     /// @{
 
-    /// Return the scalar value at the given index.
-    S& operator[](size_t i) { return _arr.at(i); }
+    /// Return the scalar value at the given index.  The index is not
+    /// bounds-checked.
+    S& operator[](size_t i) { return _arr[i]; }
 
-    /// Return the const scalar value at the given index.
-    const S& operator[](size_t i) const { return _arr.at(i); }
+    /// Return the const scalar value at the given index.  The index is not
+    /// bounds-checked.
+    const S& operator[](size_t i) const { return _arr[i]; }
 
     /// @}
     /// @name Component-wise Operators
@@ -362,11 +364,13 @@ template <class M, class S, size_t N> class MatrixN : public MatrixBase
     /// @name Indexing Operators
     /// @{
 
-    /// Return the row array at the given index.
-    RowArray& operator[](size_t i) { return _arr.at(i); }
+    /// Return the row array at the given index.  The index is not
+    /// bounds-checked.
+    RowArray& operator[](size_t i) { return _arr[i]; }
 
-    /// Return the const row array at the given index.
-    const RowArray& operator[](size_t i) const { return _arr.at(i); }
+    /// Return the const row array at the given index.  The index is not
+    /// bounds-checked.
+    const RowArray& operator[](size_t i) const { return _arr[i]; }
 
     /// @}
     /// @name Component-wise Operators
@@ -449,8 +453,8 @@ template <class M, class S, size_t N> class MatrixN : public MatrixBase
     {
         M res;
         for (size_t i = 0; i < N; i++)
-            for (size_t j = 0; j < N; j++)
-                for (size_t k = 0; k < N; k++)
+            for (size_t k = 0; k < N; k++)
+                for (size_t j = 0; j < N; j++)
                     res[i][j] += _arr[i][k] * rhs[k][j];
         return res;
     }
@@ -489,7 +493,13 @@ template <class M, class S, size_t N> class MatrixN : public MatrixBase
     /// Return the inverse of the matrix.
     M getInverse() const
     {
-        return getAdjugate() / getDeterminant();
+        // Derive the determinant from the adjugate, which already holds
+        // the cofactors of the first row.
+        M adj = getAdjugate();
+        S det{};
+        for (size_t j = 0; j < N; j++)
+            det += _arr[0][j] * adj[j][0];
+        return adj / det;
     }
 
     /// @}
@@ -605,11 +615,51 @@ class Matrix44 : public MatrixN<Matrix44, float, 4>
     static Matrix44 createRotationZ(float angle);
 
     /// @}
+    /// @name Vector Transformations
+    /// Vectors are treated as rows, and are transformed by multiplication on
+    /// the left of the matrix.
+    /// @{
+
+    /// Transform the given three-dimensional point.
+    Vector3 transformPoint(const Vector3& v) const;
+
+    /// Transform the given three-dimensional vector, ignoring translation.
+    Vector3 transformVector(const Vector3& v) const;
+
+    /// Transform the given three-dimensional normal by the inverse transpose
+    /// of the matrix.  The result is not renormalized.
+    Vector3 transformNormal(const Vector3& v) const;
+
+    /// Transform an array of three-dimensional points in place.
+    /// @param data Pointer to the first component of the first point.
+    /// @param count The number of points in the array.
+    /// @param stride The distance in floats between consecutive points, which
+    ///    must be at least three.  Components beyond the third are unmodified.
+    /// @param threadCount The number of threads across which the array may be
+    ///    split, where zero selects the hardware concurrency.  Small arrays
+    ///    are always processed on the calling thread.
+    void transformPoints(float* data, size_t count, size_t stride = 3, unsigned int threadCount = 1) const;
+
+    /// Transform an array of three-dimensional vectors in place, ignoring
+    /// translation.  Arguments are as for transformPoints.
+    void transformVectors(float* data, size_t count, size_t stride = 3, unsigned int threadCount = 1) const;
+
+    /// Transform an array of three-dimensional normals in place by the
+    /// inverse transpose of the matrix.  Results are not renormalized.
+    /// Arguments are as for transformPoints.
+    void transformNormals(float* data, size_t count, size_t stride = 3, unsigned int threadCount = 1) const;
+
+    /// @}
 
   public:
     static const Matrix44 IDENTITY;
 };
 
+// The Matrix44 product is specialized in Types.cpp, using four-wide
+// instructions on supported targets.  Per-component arithmetic remains
+// inline, where compilers vectorize it without the cost of a call.
+template <> Matrix44 MatrixN<Matrix44, float, 4>::operator*(const Matrix44& rhs) const;
+
 } // namespace MaterialX
 
 #endif
@@ -7,6 +7,8 @@
 
 #include <MaterialXCore/Element.h>
 
+#include <unordered_set>
+
 namespace MaterialX
 {
 
@@ -91,6 +93,38 @@ StringVec splitString(const string& str, const string& sep)
     return split;
 }
 
+const string* findInternedString(const string& str)
+{
+    // The table is never modified after its initialization, which is itself
+    // thread-safe, so concurrent lookups require no locking.  Other strings
+    // are stored by their owners, and are freed along with them.
+    static const std::unordered_set<string> internTable =
+    {
+        // Element categories
+        "bindinput", "bindparam", "bindtoken", "collection", "generic", "geomattr",
+        "geominfo", "geompropdef", "implementation", "input", "look", "material",
+        "materialassign", "materialx", "member", "node", "nodedef", "nodegraph",
+        "output", "parameter", "property", "propertyassign", "propertyset",
+        "propertysetassign", "shaderref", "token", "typedef", "variant",
+        "variantassign", "variantset", "visibility",
+
+        // Attribute names
+        "attrname", "channels", "cms", "cmsconfig", "collection", "colorspace",
+        "context", "default", "defaultgeomprop", "defaultinput", "doc", "encoding",
+        "enum", "enumvalues", "excludegeom", "exclusive", "file", "fileprefix",
+        "function", "geom", "geomprefix", "geomprop", "implname", "impltype",
+        "includecollection", "includegeom", "index", "inherit", "interfacename",
+        "isdefaultversion", "language", "material", "name", "namespace", "node",
+        "nodedef", "nodegraph", "nodegroup", "nodename", "output", "semantic",
+        "space", "target", "type", "uifolder", "uimax", "uimin", "uiname",
+        "uniform", "value", "variant", "variantset", "version", "viewercollection",
+        "viewergeom", "visible", "vistype", "xpos", "ypos"
+    };
+
+    std::unordered_set<string>::const_iterator it = internTable.find(str);
+    return it != internTable.end() ? &*it : nullptr;
+}
+
 string replaceSubstrings(string str, const StringMap& stringMap)
 {
     for (auto& pair : stringMap)
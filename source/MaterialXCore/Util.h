@@ -41,9 +41,65 @@ string incrementName(const string& name);
 /// separator characters.
 StringVec splitString(const string& str, const string& sep);
 
+/// Return the shared instance of the given string if it is one of the
+/// standard category or attribute names of MaterialX, or nullptr otherwise.
+/// The table of standard names is fixed when first used, so lookups require
+/// no locking, and shared instances may be compared by address.
+const string* findInternedString(const string& str);
+
 /// Apply the given substring substitutions to the input string.
 string replaceSubstrings(string str, const StringMap& stringMap);
 
+/// @class InternedString
+/// A string that refers to the shared instance of a standard MaterialX name
+/// where one exists, and otherwise stores its own copy.
+class InternedString
+{
+  public:
+    explicit InternedString(const string& str) :
+        _interned(findInternedString(str))
+    {
+        if (!_interned)
+        {
+            _owned = str;
+        }
+    }
+    ~InternedString() { }
+
+    /// Return the value of this string.
+    const string& str() const
+    {
+        return _interned ? *_interned : _owned;
+    }
+
+    /// Return true if the given string has the same value as this one,
+    /// comparing shared instances by address.
+    bool operator==(const InternedString& rhs) const
+    {
+        if (_interned && rhs._interned)
+        {
+            return _interned == rhs._interned;
+        }
+        return str() == rhs.str();
+    }
+
+    /// Return true if the given string differs in value from this one.
+    bool operator!=(const InternedString& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /// Return true if the given string has the same value as this one.
+    bool operator==(const string& rhs) const
+    {
+        return _interned == &rhs || str() == rhs;
+    }
+
+  private:
+    const string* _interned;
+    string _owned;
+};
+
 /// Pretty print the given element tree, calling asString recursively on each
 /// element in depth-first order.
 string prettyPrint(ConstElementPtr elem);
@@ -7,6 +7,12 @@
 
 #include <MaterialXCore/Util.h>
 
+#include <cerrno>
+#include <climits>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <iomanip>
 #include <sstream>
 #include <type_traits>
@@ -30,8 +36,230 @@ template <class T> class is_std_vector< vector<T> > : public std::true_type { };
 template <class T> using enable_if_std_vector_t =
     typename std::enable_if<is_std_vector<T>::value, T>::type;
 
+// The granularity and maximum size of blocks in the value storage pool.  The
+// largest pooled block holds a Matrix44 value along with its reference
+// counts.
+const size_t VALUE_POOL_GRANULARITY = 16;
+const size_t VALUE_POOL_MAX_BLOCK_SIZE = 128;
+
+// The maximum number of free blocks retained per block size and thread.
+const size_t VALUE_POOL_MAX_FREE_BLOCKS = 256;
+
+// A thread-local cache of free blocks, grouped by block size.
+class ValuePool
+{
+  public:
+    ValuePool() { }
+    ~ValuePool()
+    {
+        destroyed = true;
+        for (vector<void*>& freeBlocks : _freeBlocks)
+        {
+            for (void* block : freeBlocks)
+            {
+                ::operator delete(block);
+            }
+        }
+    }
+
+    void* allocate(size_t index)
+    {
+        vector<void*>& freeBlocks = _freeBlocks[index];
+        if (freeBlocks.empty())
+        {
+            return ::operator new(getBlockSize(index));
+        }
+        void* block = freeBlocks.back();
+        freeBlocks.pop_back();
+        return block;
+    }
+
+    void deallocate(void* ptr, size_t index)
+    {
+        vector<void*>& freeBlocks = _freeBlocks[index];
+        if (freeBlocks.size() >= VALUE_POOL_MAX_FREE_BLOCKS)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+        freeBlocks.push_back(ptr);
+    }
+
+    static size_t getBlockSize(size_t index)
+    {
+        return (index + 1) * VALUE_POOL_GRANULARITY;
+    }
+
+    // Set once the pool of the current thread has been destroyed.  Values
+    // that outlive the pool, such as those held by static objects, are
+    // allocated and released directly on the heap.
+    static thread_local bool destroyed;
+
+  private:
+    vector<void*> _freeBlocks[VALUE_POOL_MAX_BLOCK_SIZE / VALUE_POOL_GRANULARITY];
+};
+
+thread_local bool ValuePool::destroyed = false;
+thread_local ValuePool valuePool;
+
+// The size of the stack buffer used to format numeric values.
+const size_t NUMBER_BUFFER_SIZE = 64;
+
+// Return true if the C library parses and formats numbers with a period as
+// the decimal separator, allowing the direct numeric conversions below.
+bool hasStandardDecimalPoint()
+{
+    const char* point = std::localeconv()->decimal_point;
+    return point[0] == '.' && point[1] == '\0';
+}
+
+// Return true if the given character range contains only the characters of
+// a plain decimal number, optionally with a fraction and exponent.
+bool isDecimalToken(const char* begin, const char* end, bool allowFraction)
+{
+    if (begin == end)
+        return false;
+    for (const char* c = begin; c != end; c++)
+    {
+        if (isdigit(*c) || *c == '+' || *c == '-')
+            continue;
+        if (allowFraction && (*c == '.' || *c == 'e' || *c == 'E'))
+            continue;
+        return false;
+    }
+    return true;
+}
+
+// Parse a numeric value from the given character range without constructing
+// a stream.  Returns false if the range does not hold a plain decimal number
+// that converts exactly, in which case stream extraction should be used.
+template <class T> bool parseNumber(const char*, const char*, T&)
+{
+    return false;
+}
+
+template <> bool parseNumber(const char* begin, const char* end, long& data)
+{
+    if (!isDecimalToken(begin, end, false))
+        return false;
+    char* last;
+    errno = 0;
+    long value = std::strtol(begin, &last, 10);
+    if (last != end || errno == ERANGE)
+        return false;
+    data = value;
+    return true;
+}
+
+template <> bool parseNumber(const char* begin, const char* end, int& data)
+{
+    long value;
+    if (!parseNumber(begin, end, value) || value < INT_MIN || value > INT_MAX)
+        return false;
+    data = (int) value;
+    return true;
+}
+
+template <> bool parseNumber(const char* begin, const char* end, double& data)
+{
+    if (!isDecimalToken(begin, end, true) || !hasStandardDecimalPoint())
+        return false;
+    char* last;
+    errno = 0;
+    double value = std::strtod(begin, &last);
+    if (last != end || (errno == ERANGE && std::abs(value) == HUGE_VAL))
+        return false;
+    data = value;
+    return true;
+}
+
+template <> bool parseNumber(const char* begin, const char* end, float& data)
+{
+    if (!isDecimalToken(begin, end, true) || !hasStandardDecimalPoint())
+        return false;
+    char* last;
+    errno = 0;
+    float value = std::strtof(begin, &last);
+    if (last != end || (errno == ERANGE && std::abs(value) == HUGE_VALF))
+        return false;
+    data = value;
+    return true;
+}
+
+// Format a numeric value into the given buffer without constructing a
+// stream, honoring the current float format and precision.  Returns the
+// number of characters written, or zero if stream insertion should be used.
+template <class T> size_t formatNumber(const T&, char*, size_t)
+{
+    return 0;
+}
+
+size_t checkFormattedLength(int length, size_t size)
+{
+    return (length > 0 && (size_t) length < size) ? (size_t) length : 0;
+}
+
+template <> size_t formatNumber(const int& data, char* buffer, size_t size)
+{
+    return checkFormattedLength(std::snprintf(buffer, size, "%d", data), size);
+}
+
+template <> size_t formatNumber(const long& data, char* buffer, size_t size)
+{
+    return checkFormattedLength(std::snprintf(buffer, size, "%ld", data), size);
+}
+
+template <> size_t formatNumber(const double& data, char* buffer, size_t size)
+{
+    const int precision = Value::getFloatPrecision();
+    if (precision < 0 || !hasStandardDecimalPoint())
+        return 0;
+    const Value::FloatFormat fmt = Value::getFloatFormat();
+    const char* format = (fmt == Value::FloatFormatFixed ? "%.*f" :
+                         (fmt == Value::FloatFormatScientific ? "%.*e" : "%.*g"));
+    return checkFormattedLength(std::snprintf(buffer, size, format, precision, data), size);
+}
+
+template <> size_t formatNumber(const float& data, char* buffer, size_t size)
+{
+    return formatNumber<double>(data, buffer, size);
+}
+
+// Return true if the given character separates the tokens of an array.
+bool isArraySeparator(char c)
+{
+    return ARRAY_VALID_SEPARATORS.find(c) != string::npos;
+}
+
+// Call the given function with the bounds of each token in the given string,
+// as delimited by the valid array separators.  Iteration stops early if the
+// function returns false, in which case false is returned.
+template <class F> bool forEachToken(const string& str, F func)
+{
+    const char* cur = str.c_str();
+    const char* last = cur + str.size();
+    while (true)
+    {
+        while (cur != last && isArraySeparator(*cur))
+            cur++;
+        if (cur == last)
+            return true;
+        const char* tokenEnd = cur;
+        while (tokenEnd != last && !isArraySeparator(*tokenEnd))
+            tokenEnd++;
+        if (!func(cur, tokenEnd))
+            return false;
+        cur = tokenEnd;
+    }
+}
+
 template <class T> void stringToData(const string& value, T& data)
 {
+    if (parseNumber(value.c_str(), value.c_str() + value.size(), data))
+    {
+        return;
+    }
+
     std::stringstream ss(value);
     if (!(ss >> data))
     {
@@ -54,47 +282,71 @@ template <> void stringToData(const string& str, string& data)
     data = str;
 }
 
-template <class T> void stringToData(const string& str, enable_if_mx_vector_t<T>& data)
+// Convert a single array token to data, parsing numeric tokens in place.
+template <class T> void tokenToData(const char* begin, const char* end, T& data)
 {
-    StringVec tokens = splitString(str, ARRAY_VALID_SEPARATORS);
-    if (tokens.size() != data.numElements())
+    if (!parseNumber(begin, end, data))
     {
-        throw ExceptionTypeError("Type mismatch in vector stringToData: " + str);
+        stringToData(string(begin, end), data);
     }
-    for (size_t i = 0; i < data.numElements(); i++)
+}
+
+template <class T> void stringToData(const string& str, enable_if_mx_vector_t<T>& data)
+{
+    size_t count = 0;
+    bool valid = forEachToken(str, [&data, &count](const char* begin, const char* end)
+    {
+        if (count == data.numElements())
+            return false;
+        tokenToData(begin, end, data[count++]);
+        return true;
+    });
+    if (!valid || count != data.numElements())
     {
-        stringToData(tokens[i], data[i]);
+        throw ExceptionTypeError("Type mismatch in vector stringToData: " + str);
     }
 }
 
 template <class T> void stringToData(const string& str, enable_if_mx_matrix_t<T>& data)
 {
-    StringVec tokens = splitString(str, ARRAY_VALID_SEPARATORS);
-    if (tokens.size() != data.numRows() * data.numColumns())
+    const size_t numColumns = data.numColumns();
+    const size_t numElements = data.numRows() * numColumns;
+    size_t count = 0;
+    bool valid = forEachToken(str, [&data, &count, numColumns, numElements](const char* begin, const char* end)
     {
-        throw ExceptionTypeError("Type mismatch in matrix stringToData: " + str);
-    }
-    for (size_t i = 0; i < data.numRows(); i++)
+        if (count == numElements)
+            return false;
+        tokenToData(begin, end, data[count / numColumns][count % numColumns]);
+        count++;
+        return true;
+    });
+    if (!valid || count != numElements)
     {
-        for (size_t j = 0; j < data.numColumns(); j++)
-        {
-            stringToData(tokens[i * data.numRows() + j], data[i][j]);
-        }
+        throw ExceptionTypeError("Type mismatch in matrix stringToData: " + str);
     }
 }
 
 template <class T> void stringToData(const string& str, enable_if_std_vector_t<T>& data)
 {
-    for (const string& token : splitString(str, ARRAY_VALID_SEPARATORS))
+    forEachToken(str, [&data](const char* begin, const char* end)
     {
         typename T::value_type val;
-        stringToData(token, val);
+        tokenToData(begin, end, val);
         data.push_back(val);
-    }
+        return true;
+    });
 }
 
 template <class T> void dataToString(const T& data, string& str)
 {
+    char buffer[NUMBER_BUFFER_SIZE];
+    size_t length = formatNumber(data, buffer, NUMBER_BUFFER_SIZE);
+    if (length)
+    {
+        str.assign(buffer, length);
+        return;
+    }
+
     std::stringstream ss;
 
     // Set float format and precision for the stream
@@ -119,13 +371,28 @@ template <> void dataToString(const string& data, string& str)
     str = data;
 }
 
+// Append the string representation of an array element to the given string,
+// formatting numeric elements in place.
+template <class T> void appendData(const T& data, string& str)
+{
+    char buffer[NUMBER_BUFFER_SIZE];
+    size_t length = formatNumber(data, buffer, NUMBER_BUFFER_SIZE);
+    if (length)
+    {
+        str.append(buffer, length);
+        return;
+    }
+
+    string token;
+    dataToString(data, token);
+    str += token;
+}
+
 template <class T> void dataToString(const enable_if_mx_vector_t<T>& data, string& str)
 {
     for (size_t i = 0; i < data.numElements(); i++)
     {
-        string token;
-        dataToString(data[i], token);
-        str += token;
+        appendData(data[i], str);
         if (i + 1 < data.numElements())
         {
             str += ARRAY_PREFERRED_SEPARATOR;
@@ -139,9 +406,7 @@ template <class T> void dataToString(const enable_if_mx_matrix_t<T>& data, strin
     {
         for (size_t j = 0; j < data.numColumns(); j++)
         {
-            string token;
-            dataToString(data[i][j], token);
-            str += token;
+            appendData(data[i][j], str);
             if (i + 1 < data.numRows() ||
                 j + 1 < data.numColumns())
             {
@@ -155,9 +420,7 @@ template <class T> void dataToString(const enable_if_std_vector_t<T>& data, stri
 {
     for (size_t i = 0; i < data.size(); i++)
     {
-        string token;
-        dataToString<typename T::value_type>(data[i], token);
-        str += token;
+        appendData<typename T::value_type>(data[i], str);
         if (i + 1 < data.size())
         {
             str += ARRAY_PREFERRED_SEPARATOR;
@@ -171,6 +434,30 @@ template <class T> void dataToString(const enable_if_std_vector_t<T>& data, stri
 // Global functions
 //
 
+void* allocateValueStorage(size_t size)
+{
+    if (size == 0 || size > VALUE_POOL_MAX_BLOCK_SIZE)
+    {
+        return ::operator new(size);
+    }
+    size_t index = (size - 1) / VALUE_POOL_GRANULARITY;
+    if (ValuePool::destroyed)
+    {
+        return ::operator new(ValuePool::getBlockSize(index));
+    }
+    return valuePool.allocate(index);
+}
+
+void deallocateValueStorage(void* ptr, size_t size)
+{
+    if (size == 0 || size > VALUE_POOL_MAX_BLOCK_SIZE || ValuePool::destroyed)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    valuePool.deallocate(ptr, (size - 1) / VALUE_POOL_GRANULARITY);
+}
+
 template<class T> const string& getTypeString()
 {
     return TypedValue<T>::TYPE;
@@ -201,7 +488,7 @@ template <class T> const string& TypedValue<T>::getTypeString() const
 
 template <class T> string TypedValue<T>::getValueString() const
 {
-    return toValueString<T>(_data);
+    return toValueString<T>(getData());
 }
 
 template <class T> ValuePtr TypedValue<T>::createFromString(const string& value)
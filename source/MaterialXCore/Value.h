@@ -13,6 +13,8 @@
 
 #include <MaterialXCore/Types.h>
 
+#include <type_traits>
+
 namespace MaterialX
 {
 
@@ -25,6 +27,46 @@ using ConstValuePtr = shared_ptr<const Value>;
 
 template <class T> class TypedValue;
 
+/// Allocate storage for a value object from a thread-local pool of recycled
+/// blocks.  Requests larger than the pooled block sizes are forwarded to
+/// the global operator new.
+void* allocateValueStorage(size_t size);
+
+/// Return storage allocated by allocateValueStorage to its pool.
+void deallocateValueStorage(void* ptr, size_t size);
+
+/// @class ValueAllocator
+/// An allocator that draws value objects and their reference counts from a
+/// thread-local pool, so that short-lived values may be created without a
+/// heap allocation.
+template <class T> class ValueAllocator
+{
+  public:
+    using value_type = T;
+
+    ValueAllocator() { }
+    template <class U> ValueAllocator(const ValueAllocator<U>&) { }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(allocateValueStorage(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        deallocateValueStorage(ptr, n * sizeof(T));
+    }
+
+    template <class U> bool operator==(const ValueAllocator<U>&) const
+    {
+        return true;
+    }
+    template <class U> bool operator!=(const ValueAllocator<U>&) const
+    {
+        return false;
+    }
+};
+
 /// A generic, discriminated value, whose type may be queried dynamically.
 class Value
 {
@@ -46,7 +88,7 @@ class Value
     /// Create a new value from an object of any valid MaterialX type.
     template<class T> static ValuePtr createValue(const T& data)
     {
-        return std::make_shared< TypedValue<T> >(data);
+        return std::allocate_shared< TypedValue<T> >(ValueAllocator< TypedValue<T> >(), data);
     }
 
     /// Create a new value instance from value and type strings.
@@ -126,42 +168,175 @@ class Value
     static int _floatPrecision;
 };
 
-/// The class template for typed subclasses of Value
-template <class T> class TypedValue : public Value
+/// @class TypedValueStorage
+/// The data storage of a TypedValue, which holds scalar, vector, color and
+/// matrix data inline.
+template <class T, bool Shared> class TypedValueStorage
 {
   public:
-    TypedValue() :
+    TypedValueStorage() :
         _data{}
     {
     }
+    explicit TypedValueStorage(const T& data) :
+        _data(data)
+    {
+    }
+    ~TypedValueStorage() { }
+
+    const T& get() const
+    {
+        return _data;
+    }
+
+    void set(const T& data)
+    {
+        _data = data;
+    }
+
+    void share(const TypedValueStorage& storage)
+    {
+        _data = storage._data;
+    }
+
+  private:
+    T _data;
+};
+
+/// The data storage of a TypedValue for string and array data.  Data are
+/// held inline until the value is first copied, at which point a single
+/// immutable copy of non-empty data is placed in shared storage, and is
+/// referenced by all later copies.
+template <class T> class TypedValueStorage<T, true>
+{
+  public:
+    TypedValueStorage() :
+        _data{},
+        _isShared(false)
+    {
+    }
+    explicit TypedValueStorage(const T& data) :
+        _data(data),
+        _isShared(false)
+    {
+    }
+    TypedValueStorage(const TypedValueStorage& storage) :
+        _data{},
+        _isShared(false)
+    {
+        share(storage);
+    }
+    ~TypedValueStorage() { }
+
+    TypedValueStorage& operator=(const TypedValueStorage& storage)
+    {
+        share(storage);
+        return *this;
+    }
+
+    const T& get() const
+    {
+        return _isShared ? *_shared : _data;
+    }
+
+    void set(const T& data)
+    {
+        _data = data;
+        _shared.reset();
+        _isShared = false;
+    }
+
+    void share(const TypedValueStorage& storage)
+    {
+        if (&storage == this)
+        {
+            return;
+        }
+        shared_ptr<const T> shared = storage.getShared();
+        if (!shared)
+        {
+            set(storage.get());
+            return;
+        }
+        _data = T{};
+        _shared = std::move(shared);
+        _isShared = true;
+    }
+
+  private:
+    // Return the shared storage of non-empty data, creating it on first use.
+    // Inline data is left unchanged, so concurrent readers are unaffected.
+    shared_ptr<const T> getShared() const
+    {
+        if (_isShared)
+        {
+            return _shared;
+        }
+        if (_data.empty())
+        {
+            return nullptr;
+        }
+        shared_ptr<const T> shared = std::atomic_load(&_shared);
+        if (!shared)
+        {
+            shared_ptr<const T> created = std::allocate_shared<T>(ValueAllocator<T>(), _data);
+            if (std::atomic_compare_exchange_strong(&_shared, &shared, created))
+            {
+                shared = created;
+            }
+        }
+        return shared;
+    }
+
+  private:
+    T _data;
+    mutable shared_ptr<const T> _shared;
+    bool _isShared;
+};
+
+/// The class template for typed subclasses of Value
+///
+/// Data are stored inline within the value object.  Non-empty string and
+/// array data are shared between the copies of a value, until a new data
+/// object is set.
+template <class T> class TypedValue : public Value
+{
+    using Storage = TypedValueStorage<T,
+        !std::is_arithmetic<T>::value &&
+        !std::is_base_of<VectorBase, T>::value &&
+        !std::is_base_of<MatrixBase, T>::value>;
+
+  public:
+    TypedValue() { }
     explicit TypedValue(const T& value) :
         _data(value)
     {
     }
     virtual ~TypedValue() { }
 
-    /// Create a deep copy of the value.
+    /// Create a copy of the value.  Non-empty string and array data are
+    /// shared with the copy rather than duplicated.
     ValuePtr copy() const override
     {
-        return Value::createValue<T>(_data);
+        return std::allocate_shared< TypedValue<T> >(ValueAllocator< TypedValue<T> >(), *this);
     }
 
     /// Set stored data object.
     void setData(const T& value)
     {
-        _data = value;
+        _data.set(value);
     }
 
     /// Set stored data object.
     void setData(const TypedValue<T>& value)
     {
-        _data = value._data;
+        _data.share(value._data);
     }
 
     /// Return stored data object.
     const T& getData() const
     {
-        return _data;
+        return _data.get();
     }
 
     /// Return type string.
@@ -183,7 +358,7 @@ template <class T> class TypedValue : public Value
     static const string TYPE;
 
   private:
-    T _data;
+    Storage _data;
 };
 
 /// @class ExceptionTypeError
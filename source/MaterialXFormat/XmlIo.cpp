@@ -78,10 +78,10 @@ void elementToXml(ConstElementPtr elem, xml_node& xmlNode, const XmlWriteOptions
     {
         xmlNode.append_attribute(Element::NAME_ATTRIBUTE.c_str()) = elem->getName().c_str();
     }
-    for (const string& attrName : elem->getAttributeNames())
+    for (const Element::Attribute& attr : elem->getAttributes())
     {
-        xml_attribute xmlAttr = xmlNode.append_attribute(attrName.c_str());
-        xmlAttr.set_value(elem->getAttribute(attrName).c_str());
+        xml_attribute xmlAttr = xmlNode.append_attribute(attr.first.str().c_str());
+        xmlAttr.set_value(attr.second.c_str());
     }
 
     // Create child nodes and recurse.
@@ -164,6 +164,7 @@ void processXIncludes(DocumentPtr doc, xml_node& xmlNode, const string& searchPa
                 DocumentPtr library = createDocument();
                 XmlReadOptions xiReadOptions = readOptions ? *readOptions : XmlReadOptions();
                 xiReadOptions.parentFilenames.insert(filename);
+                xiReadOptions.bulkLoad = true;
                 readXIncludeFunction(library, filename, searchPath, &xiReadOptions);
 
                 // Import the library document.
@@ -193,6 +194,12 @@ void documentFromXml(DocumentPtr doc,
     xml_node xmlRoot = xmlDoc.child(Document::CATEGORY.c_str());
     if (xmlRoot)
     {
+        std::unique_ptr<ScopedBulkLoad> bulkLoad;
+        if (readOptions && readOptions->bulkLoad)
+        {
+            bulkLoad.reset(new ScopedBulkLoad(doc));
+        }
+
         processXIncludes(doc, xmlRoot, searchPath, readOptions);
         elementFromXml(xmlRoot, doc, readOptions);
     }
@@ -207,7 +214,8 @@ void documentFromXml(DocumentPtr doc,
 //
 
 XmlReadOptions::XmlReadOptions() :
-    readXIncludeFunction(readFromXmlFile)
+    readXIncludeFunction(readFromXmlFile),
+    bulkLoad(false)
 {
 }
 
@@ -37,6 +37,11 @@ class XmlReadOptions : public CopyOptions
     /// The set of parent filenames at the scope of the current document.
     /// Defaults to an empty set.
     StringSet parentFilenames;
+
+    /// If true, then elements are read into the document as a bulk load,
+    /// skipping per-element change notifications in favor of a single call
+    /// to Document::onBulkLoad.  Defaults to false.
+    bool bulkLoad;
 };
 
 /// @class XmlWriteOptions
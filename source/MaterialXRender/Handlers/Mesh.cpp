@@ -5,6 +5,7 @@
 
 #include <MaterialXRender/Handlers/Mesh.h>
 
+#include <limits>
 #include <map>
 
 namespace MaterialX
@@ -19,6 +20,27 @@ const string MeshStream::GEOMETRY_PROPERTY_ATTRIBUTE("geomprop");
 
 const float MAX_FLOAT = std::numeric_limits<float>::max();
 
+void MeshStream::transform(const Matrix44& matrix, unsigned int threadCount)
+{
+    if (_stride < 3)
+    {
+        return;
+    }
+    size_t count = _data.size() / _stride;
+    if (_type == POSITION_ATTRIBUTE)
+    {
+        matrix.transformPoints(_data.data(), count, _stride, threadCount);
+    }
+    else if (_type == NORMAL_ATTRIBUTE)
+    {
+        matrix.transformNormals(_data.data(), count, _stride, threadCount);
+    }
+    else if (_type == TANGENT_ATTRIBUTE || _type == BITANGENT_ATTRIBUTE)
+    {
+        matrix.transformVectors(_data.data(), count, _stride, threadCount);
+    }
+}
+
 Mesh::Mesh(const string& identifier) :
     _identifier(identifier),
     _minimumBounds(MAX_FLOAT, MAX_FLOAT, MAX_FLOAT),
@@ -114,6 +114,14 @@ class MeshStream
         _stride = stride;
     }
 
+    /// Transform the elements of this stream by the given matrix, treating
+    /// them as points, normals or vectors according to the stream type.
+    /// Streams of other types are left unmodified.
+    /// @param matrix The transformation matrix
+    /// @param threadCount The number of threads across which the stream may
+    ///    be split, where zero selects the hardware concurrency.
+    void transform(const Matrix44& matrix, unsigned int threadCount = 1);
+
   protected:
     string _name;
     string _type;
@@ -779,7 +779,7 @@ void GlslProgram::bindUniform(int location, const Value& value)
         throw ExceptionShaderValidationError(errorType, errors);
     }
 
-    if (location >= 0 && value.getValueString() != EMPTY_STRING)
+    if (location >= 0)
     {
         if (value.getTypeString() == "float")
         {
@@ -826,7 +826,7 @@ void GlslProgram::bindUniform(int location, const Value& value)
             Vector4 v = value.asA<Vector4>();
             glUniform4f(location, v[0], v[1], v[2], v[3]);
         }
-        else
+        else if (value.getValueString() != EMPTY_STRING)
         {
             throw ExceptionShaderValidationError(
                 "GLSL input binding error.",
@@ -7,6 +7,8 @@
 
 #include <MaterialXCore/Document.h>
 
+#include <thread>
+
 namespace mx = MaterialX;
 
 TEST_CASE("Document", "[document]")
@@ -42,6 +44,25 @@ TEST_CASE("Document", "[document]")
     REQUIRE(nodeGraph->getDescendant("node1") == constant);
     REQUIRE(nodeGraph->getDescendant("missingNode") == mx::ElementPtr());
 
+    // Test name paths and lookups after renaming, removal and re-addition.
+    nodeGraph->setName("renamedGraph");
+    REQUIRE(constant->getNamePath() == "renamedGraph/node1");
+    REQUIRE(doc->getDescendant("renamedGraph/node1") == constant);
+    REQUIRE(doc->getDescendant("nodegraph1/node1") == mx::ElementPtr());
+    REQUIRE(doc->getDescendant("renamedGraph//node1") == constant);
+    mx::NodePtr detached = nodeGraph->addNode("constant", "detached");
+    mx::ElementPtr detachedChild = detached->addChildOfCategory("child", "child1");
+    REQUIRE(doc->getDescendant("renamedGraph/detached/child1") == detachedChild);
+    nodeGraph->removeNode("detached");
+    REQUIRE(doc->getDescendant("renamedGraph/detached") == mx::ElementPtr());
+    mx::NodePtr replacement = nodeGraph->addNode("constant", "detached");
+    REQUIRE(doc->getDescendant("renamedGraph/detached") == replacement);
+    REQUIRE(detached->getDescendant("child1") == detachedChild);
+    nodeGraph->removeNode("detached");
+    nodeGraph->setName("nodegraph1");
+    REQUIRE(constant->getNamePath() == "nodegraph1/node1");
+    REQUIRE(doc->getDescendant("nodegraph1/node1") == constant);
+
     // Create a simple shader interface.
     mx::NodeDefPtr shader = doc->addNodeDef("", "surfaceshader", "simpleSrf");
     mx::InputPtr diffColor = shader->addInput("diffColor", "color3");
@@ -108,3 +129,153 @@ TEST_CASE("Document", "[document]")
     // Validate the combined document.
     REQUIRE(doc->validate());
 }
+
+TEST_CASE("Document cache", "[document]")
+{
+    // Create a document with a nodedef, implementation and node graph.
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeDefPtr nodeDef = doc->addNodeDef("ND_custom", "color3", "custom");
+    mx::ImplementationPtr impl = doc->addImplementation("IM_custom");
+    impl->setNodeDef(nodeDef);
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    mx::NodePtr constant = nodeGraph->addNode("constant");
+    mx::OutputPtr output = nodeGraph->addOutput();
+    output->setConnectedNode(constant);
+    const std::string& nodeName = constant->getName();
+
+    // Build the initial cache.
+    REQUIRE(doc->getMatchingNodeDefs("custom").size() == 1);
+    REQUIRE(doc->getMatchingImplementations("ND_custom").size() == 1);
+    REQUIRE(doc->getMatchingPorts(nodeName).size() == 1);
+
+    // Edit and remove cached attributes.
+    nodeDef->setNodeString("custom2");
+    REQUIRE(doc->getMatchingNodeDefs("custom").empty());
+    REQUIRE(doc->getMatchingNodeDefs("custom2").size() == 1);
+    impl->removeAttribute(mx::InterfaceElement::NODE_DEF_ATTRIBUTE);
+    REQUIRE(doc->getMatchingImplementations("ND_custom").empty());
+    impl->setNodeDef(nodeDef);
+    REQUIRE(doc->getMatchingImplementations("ND_custom").size() == 1);
+
+    // Add and remove connected ports.
+    mx::OutputPtr output2 = nodeGraph->addOutput();
+    output2->setConnectedNode(constant);
+    REQUIRE(doc->getMatchingPorts(nodeName).size() == 2);
+    nodeGraph->removeOutput(output2->getName());
+    REQUIRE(doc->getMatchingPorts(nodeName).size() == 1);
+    output2->setNodeName(nodeName);
+    REQUIRE(doc->getMatchingPorts(nodeName).size() == 1);
+
+    // Copy content into new elements.
+    mx::NodeGraphPtr graphCopy = doc->addNodeGraph();
+    graphCopy->copyContentFrom(nodeGraph);
+    REQUIRE(doc->getMatchingPorts(nodeName).size() == 2);
+    mx::NodeDefPtr nodeDefCopy = doc->addNodeDef();
+    nodeDefCopy->copyContentFrom(nodeDef);
+    REQUIRE(doc->getMatchingNodeDefs("custom2").size() == 2);
+    nodeDefCopy->clearContent();
+    REQUIRE(doc->getMatchingNodeDefs("custom2").size() == 1);
+
+    // Apply a namespace to a node graph.
+    nodeGraph->setNamespace("ns");
+    REQUIRE(doc->getMatchingPorts("ns:" + nodeName).size() == 1);
+    REQUIRE(doc->getMatchingPorts(nodeName).size() == 1);
+    doc->removeNodeGraph(graphCopy->getName());
+    REQUIRE(doc->getMatchingPorts(nodeName).empty());
+
+    // Query the cache during a bulk load, where each edit marks the cache
+    // as stale, and repeated queries reuse the rebuilt cache.
+    doc->beginBulkLoad();
+    nodeDef->setNodeString("custom3");
+    mx::NodeGraphPtr bulkGraph = doc->addNodeGraph("bulkGraph");
+    mx::NodePtr bulkNode = bulkGraph->addNode("constant", "bulkNode");
+    REQUIRE(doc->getMatchingNodeDefs("custom2").empty());
+    REQUIRE(doc->getMatchingNodeDefs("custom3").size() == 1);
+    REQUIRE(doc->getDescendant("bulkGraph/bulkNode") == bulkNode);
+    bulkGraph->addOutput()->setConnectedNode(bulkNode);
+    mx::ConstGeomPathIndexPtr bulkIndex = doc->getGeomPathIndex();
+    for (int i = 0; i < 4; i++)
+    {
+        REQUIRE(bulkNode->getDownstreamPorts().size() == 1);
+        REQUIRE(doc->getMatchingNodeDefs("custom3").size() == 1);
+        REQUIRE(doc->getGeomPathIndex() == bulkIndex);
+    }
+    mx::OutputPtr bulkOutput = bulkGraph->addOutput();
+    REQUIRE(doc->getGeomPathIndex() != bulkIndex);
+    bulkOutput->setConnectedNode(bulkNode);
+    REQUIRE(bulkNode->getDownstreamPorts().size() == 2);
+    bulkGraph->removeOutput(bulkOutput->getName());
+    REQUIRE(bulkNode->getDownstreamPorts().size() == 1);
+    doc->endBulkLoad();
+    REQUIRE(doc->getMatchingNodeDefs("custom3").size() == 1);
+    REQUIRE(bulkNode->getDownstreamPorts().size() == 1);
+
+    // Query the cache from concurrent readers.
+    for (int i = 0; i < 16; i++)
+    {
+        mx::NodeDefPtr nodeDef = doc->addNodeDef("", "float", "node" + std::to_string(i));
+        doc->addImplementation()->setNodeDef(nodeDef);
+    }
+    std::vector<std::thread> readers;
+    std::vector<int> matchCounts(4, 0);
+    for (size_t t = 0; t < matchCounts.size(); t++)
+    {
+        readers.emplace_back([&doc, &matchCounts, t]()
+        {
+            for (int i = 0; i < 16; i++)
+            {
+                mx::NodeDefPtr nodeDef = doc->getMatchingNodeDefs("node" + std::to_string(i))[0];
+                matchCounts[t] += (int) doc->getMatchingImplementations(nodeDef->getName()).size();
+            }
+        });
+    }
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+    for (int matchCount : matchCounts)
+    {
+        REQUIRE(matchCount == 16);
+    }
+}
+
+TEST_CASE("Parallel validation", "[document]")
+{
+    // Create a document with a set of node graphs.
+    mx::DocumentPtr doc = mx::createDocument();
+    std::vector<mx::OutputPtr> outputs;
+    for (int i = 0; i < 32; i++)
+    {
+        mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+        mx::NodePtr constant = nodeGraph->addNode("constant");
+        constant->setParameterValue("value", mx::Color3(0.5f));
+        mx::OutputPtr output = nodeGraph->addOutput();
+        output->setConnectedNode(constant);
+        outputs.push_back(output);
+    }
+    REQUIRE(doc->validateParallel(nullptr, 4));
+
+    // Introduce errors in several node graphs and in the document itself.
+    outputs[3]->setType("float");
+    outputs[17]->setType("float");
+    outputs[30]->setInheritString("missing");
+    doc->removeAttribute(mx::Document::VERSION_ATTRIBUTE);
+
+    // Compare parallel results to the serial path.
+    std::string serialMessage;
+    REQUIRE(!doc->validate(&serialMessage));
+    for (unsigned int threadCount : { 1u, 4u, 0u })
+    {
+        std::string parallelMessage;
+        std::vector<mx::ValidationDiagnostic> diagnostics;
+        REQUIRE(!doc->validateParallel(&parallelMessage, threadCount, &diagnostics));
+        REQUIRE(parallelMessage == serialMessage);
+        REQUIRE(diagnostics.size() == 4);
+        REQUIRE(diagnostics[0].element == doc);
+        REQUIRE(diagnostics[0].message.find("Missing version string") != std::string::npos);
+        REQUIRE(diagnostics[1].element == outputs[3]->getParent());
+        REQUIRE(diagnostics[2].element == outputs[17]->getParent());
+        REQUIRE(diagnostics[3].element == outputs[30]->getParent());
+        REQUIRE(diagnostics[3].message.find("Invalid element inheritance") != std::string::npos);
+    }
+}
@@ -21,6 +21,7 @@ TEST_CASE("Element", "[element]")
     REQUIRE(elem2->getParent() == doc);
     REQUIRE(elem1->getRoot() == doc);
     REQUIRE(elem2->getRoot() == doc);
+    REQUIRE(elem1->addChildOfCategory("generic")->getDocument() == doc);
     REQUIRE(doc->getChildren()[0] == elem1);
     REQUIRE(doc->getChildren()[1] == elem2);
 
@@ -40,6 +41,36 @@ TEST_CASE("Element", "[element]")
     REQUIRE(elem1->getTypedAttribute<bool>("customColor") == false);
     REQUIRE(elem1->getTypedAttribute<mx::Color3>("customFlag") == mx::Color3(0.0f));
 
+    // Modify attributes, preserving the order in which they were set.
+    elem1->setAttribute("customFlag", "false");
+    elem1->setAttribute("customName", "name1");
+    REQUIRE(elem1->getAttributeNames() == (mx::StringVec{"customFlag", "customColor", "customName"}));
+    elem1->removeAttribute("customColor");
+    REQUIRE(elem1->getAttributeNames() == (mx::StringVec{"customFlag", "customName"}));
+    REQUIRE(elem1->getAttributes()[1].first.str() == "customName");
+    REQUIRE(elem1->getAttributes()[1].second == "name1");
+    REQUIRE(elem1->getAttribute("customFlag") == "false");
+    REQUIRE(!elem1->hasAttribute("customColor"));
+
+    // Set and remove a large number of attributes.
+    for (int i = 0; i < 40; i++)
+    {
+        elem2->setAttribute("attr" + std::to_string(i), std::to_string(i));
+    }
+    for (int i = 0; i < 40; i += 2)
+    {
+        elem2->removeAttribute("attr" + std::to_string(i));
+    }
+    REQUIRE(elem2->getAttributeNames().size() == 20);
+    REQUIRE(elem2->getAttributeNames()[0] == "attr1");
+    REQUIRE(elem2->getAttribute("attr39") == "39");
+    REQUIRE(!elem2->hasAttribute("attr38"));
+    for (int i = 1; i < 40; i += 2)
+    {
+        elem2->removeAttribute("attr" + std::to_string(i));
+    }
+    REQUIRE(elem2->getAttributeNames().empty());
+
     // Modify element names.
     elem1->setName("elem1");
     elem2->setName("elem2");
@@ -57,6 +88,102 @@ TEST_CASE("Element", "[element]")
     REQUIRE_THROWS_AS(doc2->setChildIndex("elem1", 100), mx::Exception&);
     REQUIRE(*doc2 == *doc);
 
+    // Compare content hashes.
+    size_t docHash = doc->getContentHash();
+    REQUIRE(doc2->getContentHash() == docHash);
+    doc2->setChildIndex("elem1", 1);
+    REQUIRE(doc2->getContentHash() != docHash);
+    doc2->setChildIndex("elem1", 0);
+    REQUIRE(doc2->getContentHash() == docHash);
+    doc2->getChild("elem2")->setAttribute("attr", "value");
+    REQUIRE(doc2->getContentHash() != docHash);
+    doc2->getChild("elem2")->removeAttribute("attr");
+    REQUIRE(doc2->getContentHash() == docHash);
+    doc2->getChild("elem1")->setName("elem3");
+    REQUIRE(doc2->getContentHash() != docHash);
+    doc2->getChild("elem3")->setName("elem1");
+    REQUIRE(doc2->getContentHash() == docHash);
+
+    // Compare element trees with and without cached content hashes.
+    doc2->getChild("elem2")->setAttribute("attr", "value");
+    REQUIRE(*doc2 != *doc);
+    REQUIRE(doc2->getContentHash() != docHash);
+    REQUIRE(*doc2 != *doc);
+    doc2->getChild("elem2")->removeAttribute("attr");
+    REQUIRE(*doc2 == *doc);
+
+    // Remove and reorder children of a larger element.
+    mx::ElementPtr parent = doc2->addChildOfCategory("generic");
+    for (int i = 0; i < 100; i++)
+    {
+        parent->addChildOfCategory("generic", "child" + std::to_string(i));
+    }
+    for (int i = 0; i < 100; i += 3)
+    {
+        parent->removeChild("child" + std::to_string(i));
+    }
+    REQUIRE(parent->getChildIndex("child1") == 0);
+    REQUIRE(parent->getChildIndex("child3") == -1);
+    REQUIRE(parent->getChildIndex("child98") == 65);
+    parent->setChildIndex("child98", 0);
+    parent->setChildIndex("child1", 65);
+    REQUIRE(parent->getChildren().size() == 66);
+    REQUIRE(parent->getChildren()[0]->getName() == "child98");
+    REQUIRE(parent->getChildren()[1]->getName() == "child2");
+    REQUIRE(parent->getChildren()[65]->getName() == "child1");
+    REQUIRE_THROWS_AS(parent->setChildIndex("child1", 66), mx::Exception&);
+    for (size_t i = 0; i < parent->getChildren().size(); i++)
+    {
+        REQUIRE(parent->getChildIndex(parent->getChildren()[i]->getName()) == (int) i);
+    }
+
+    // Remove children while iterating over a copy of the child vector.
+    std::vector<mx::ElementPtr> children = parent->getChildren();
+    for (mx::ElementPtr child : children)
+    {
+        if (child->getName() != "child1")
+        {
+            parent->removeChild(child->getName());
+        }
+    }
+    REQUIRE(parent->getChildren().size() == 1);
+    REQUIRE(parent->getChildIndex("child1") == 0);
+
+    // Generate unique child names.
+    mx::ElementPtr names = doc2->addChildOfCategory("generic");
+    for (int i = 0; i < 100; i++)
+    {
+        names->addChildOfCategory("generic", names->createValidChildName("child"));
+    }
+    REQUIRE(names->getChild("child"));
+    REQUIRE(!names->getChild("child1"));
+    REQUIRE(names->getChild("child100"));
+    REQUIRE(names->createValidChildName("child2") == "child101");
+    REQUIRE(names->createValidChildName("child50") == "child101");
+    names->removeChild("child51");
+    REQUIRE(names->createValidChildName("child2") == "child51");
+    names->getChild("child99")->setName("renamed");
+    REQUIRE(names->createValidChildName("child52") == "child99");
+    REQUIRE(names->createValidChildName("renamed") == "renamed2");
+    doc2->removeChild(names->getName());
+    doc2->removeChild(parent->getName());
+
+    // Cache parsed values.
+    mx::NodeGraphPtr nodeGraph = doc2->addNodeGraph();
+    mx::NodePtr constant = nodeGraph->addNode("constant");
+    mx::ParameterPtr param = constant->setParameterValue("value", 0.5f);
+    mx::ValuePtr value = param->getValue();
+    REQUIRE(param->getValue() == value);
+    param->setValueString("0.25");
+    REQUIRE(param->getValue() != value);
+    REQUIRE(param->getValue()->asA<float>() == 0.25f);
+    param->setType("color3");
+    param->setValueString("1, 1, 1");
+    REQUIRE(param->getValue()->asA<mx::Color3>() == mx::Color3(1.0f));
+    param->removeAttribute(mx::ValueElement::VALUE_ATTRIBUTE);
+    REQUIRE(!param->getValue());
+    doc2->removeNodeGraph(nodeGraph->getName());
+
     // Create and test an orphaned element.
     mx::ElementPtr orphan;
     {
@@ -66,3 +193,34 @@ TEST_CASE("Element", "[element]")
     }
     REQUIRE_THROWS_AS(orphan->getDocument(), mx::ExceptionOrphanedElement&);    
 }
+
+TEST_CASE("Element arena", "[element]")
+{
+    // Create a document whose elements are allocated from an arena.
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->setElementArenaEnabled(true);
+    REQUIRE(doc->getElementArena());
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    for (int i = 0; i < 1000; i++)
+    {
+        mx::NodePtr node = nodeGraph->addNode("constant");
+        node->setParameterValue("value", mx::Color3(0.5f));
+    }
+    REQUIRE(nodeGraph->getElementArena() == doc->getElementArena());
+    REQUIRE(doc->getElementArena()->getReservedSize() >= mx::ElementArena::DEFAULT_BLOCK_SIZE);
+    REQUIRE(nodeGraph->getNodes().size() == 1000);
+    REQUIRE(doc->validate());
+
+    // Copies of the document inherit arena allocation.
+    mx::DocumentPtr doc2 = doc->copy();
+    REQUIRE(doc2->getElementArena());
+    REQUIRE(doc2->getElementArena() != doc->getElementArena());
+    REQUIRE(*doc2 == *doc);
+
+    // Arena elements remain valid after their document is released.
+    mx::NodePtr orphan = nodeGraph->getNodes()[0];
+    doc = nullptr;
+    nodeGraph = nullptr;
+    REQUIRE(orphan->getParameterValue("value")->asA<mx::Color3>() == mx::Color3(0.5f));
+    REQUIRE_THROWS_AS(orphan->getDocument(), mx::ExceptionOrphanedElement&);
+}
@@ -22,6 +22,81 @@ TEST_CASE("Geom strings", "[geom]")
     // Test that one path contains another.
     REQUIRE(mx::geomStringsMatch("/", "/robot1", true));
     REQUIRE(!mx::geomStringsMatch("/robot1", "/", true));
+    REQUIRE(mx::geomStringsMatch("/robot1/left_arm", "/robot1/left_arm", true));
+    REQUIRE(!mx::geomStringsMatch("/robot1/left_arm", "/robot1/left", true));
+}
+
+TEST_CASE("Geom path index", "[geom]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+
+    // Create a look with geometry and collection assignments.
+    mx::LookPtr look = doc->addLook();
+    mx::MaterialAssignPtr assign1 = look->addMaterialAssign("assign1");
+    assign1->setGeom("/robot1, /robot2/left_arm");
+    mx::MaterialAssignPtr assign2 = look->addMaterialAssign("assign2");
+    assign2->setGeom("/");
+    mx::PropertyAssignPtr propAssign = look->addPropertyAssign("propAssign");
+    propAssign->setGeom("/robot2/left_arm/hand");
+    mx::VisibilityPtr visibility = look->addVisibility("visibility");
+    mx::CollectionPtr collection = doc->addCollection("collection");
+    collection->setIncludeGeom("/robot3");
+    visibility->setCollection(collection);
+    mx::GeomInfoPtr geomInfo = doc->addGeomInfo("geomInfo", "/robot2");
+
+    // Compare indexed queries with direct matching of geometry strings.
+    mx::StringVec geoms = { "", "/", "/robot1", "/robot1/left_arm", "/robot2", "/robot2/left_arm",
+                            "/robot2/right_arm", "/robot3/head", "/robot4", "/robot4, /robot1" };
+    mx::ConstGeomPathIndexPtr index = doc->getGeomPathIndex();
+    REQUIRE(index->getElementCount() == 5);
+    for (const std::string& geom : geoms)
+    {
+        std::vector<mx::ElementPtr> expected;
+        if (mx::geomStringsMatch(geom, assign1->getActiveGeom()))
+            expected.push_back(assign1);
+        if (mx::geomStringsMatch(geom, assign2->getActiveGeom()))
+            expected.push_back(assign2);
+        if (mx::geomStringsMatch(geom, propAssign->getGeom()))
+            expected.push_back(propAssign);
+        if (collection->matchesGeomString(geom))
+            expected.push_back(visibility);
+        if (mx::geomStringsMatch(geom, geomInfo->getActiveGeom()))
+            expected.push_back(geomInfo);
+        REQUIRE(index->getMatchingElements(geom) == expected);
+    }
+
+    // Resolve the same queries as a batch.
+    std::vector<std::vector<mx::ElementPtr>> results = index->getMatchingElements(geoms, 0);
+    REQUIRE(results.size() == geoms.size());
+    for (size_t i = 0; i < geoms.size(); i++)
+    {
+        REQUIRE(results[i] == index->getMatchingElements(geoms[i]));
+    }
+
+    // Verify that the cached index tracks document edits.
+    REQUIRE(doc->getGeomPathIndex() == index);
+    assign1->setGeom("/robot4");
+    mx::ConstGeomPathIndexPtr editedIndex = doc->getGeomPathIndex();
+    REQUIRE(editedIndex != index);
+    std::vector<mx::ElementPtr> robot4Matches = { assign1, assign2 };
+    REQUIRE(editedIndex->getMatchingElements("/robot4/head") == robot4Matches);
+    look->setGeomPrefix("/scene");
+    REQUIRE(doc->getGeomPathIndex()->getMatchingElements("/scene/robot4").size() == 2);
+
+    // Replace an assignment with an identical assignment.
+    look->removeMaterialAssign("assign2");
+    mx::MaterialAssignPtr assign3 = look->addMaterialAssign("assign2");
+    assign3->setGeom("/");
+    look->setChildIndex("assign2", 1);
+    std::vector<mx::ElementPtr> replacedMatches = { assign1, assign3 };
+    REQUIRE(doc->getGeomPathIndex()->getMatchingElements("/scene/robot4") == replacedMatches);
+
+    // Query the index during a bulk load.
+    doc->beginBulkLoad();
+    assign3->setGeom("/robot5");
+    REQUIRE(doc->getGeomPathIndex()->getMatchingElements("/scene/robot4").size() == 1);
+    doc->endBulkLoad();
+    REQUIRE(doc->getGeomPathIndex()->getMatchingElements("/scene/robot5").size() == 1);
 }
 
 TEST_CASE("Geom elements", "[geom]")
@@ -85,6 +160,73 @@ TEST_CASE("Geom elements", "[geom]")
     REQUIRE(!collection1->matchesGeomString("/root/scene2"));
 }
 
+TEST_CASE("Collection matching", "[geom]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+
+    // Create a diamond of included collections, with exclusions at each level.
+    mx::CollectionPtr base = doc->addCollection("base");
+    base->setIncludeGeom("/scene1, /scene2");
+    base->setExcludeGeom("/scene1/hidden");
+    mx::CollectionPtr left = doc->addCollection("left");
+    left->setIncludeGeom("/scene3");
+    left->setExcludeGeom("/scene2");
+    left->setIncludeCollection(base);
+    mx::CollectionPtr right = doc->addCollection("right");
+    right->setIncludeCollection(base);
+    mx::CollectionPtr top = doc->addCollection("top");
+    top->setExcludeGeom("/scene3/hidden");
+    top->setIncludeCollections({ left, right });
+    REQUIRE(!top->hasIncludeCycle());
+    REQUIRE(doc->validate());
+
+    // Exclusions apply to the include geometry of their own collection, and
+    // not to the collections that it includes.
+    mx::StringVec geoms = { "/scene1/sphere", "/scene1/hidden", "/scene2/sphere",
+                            "/scene3/sphere", "/scene3/hidden", "/scene4" };
+    std::vector<bool> expected = { true, false, true, true, false, false };
+    for (size_t i = 0; i < geoms.size(); i++)
+    {
+        REQUIRE(top->matchesGeomString(geoms[i]) == expected[i]);
+    }
+    REQUIRE(!left->matchesGeomString("/scene2/sphere"));
+    REQUIRE(top->matchesGeomStrings(geoms) == expected);
+    REQUIRE(top->matchesGeomStrings(geoms, 0) == expected);
+
+    // Edits to included collections are reflected in subsequent queries.
+    base->setIncludeGeom("/scene4");
+    REQUIRE(top->matchesGeomString("/scene4/sphere"));
+    REQUIRE(!top->matchesGeomString("/scene1/sphere"));
+
+    // Additions, removals and renames of included collections are reflected.
+    right->setIncludeCollections({ base, doc->addCollection("extra") });
+    REQUIRE(!top->matchesGeomString("/scene6/sphere"));
+    doc->getCollection("extra")->setIncludeGeom("/scene6");
+    REQUIRE(top->matchesGeomString("/scene6/sphere"));
+    doc->removeCollection("extra");
+    REQUIRE(!top->matchesGeomString("/scene6/sphere"));
+    mx::CollectionPtr extra = doc->addCollection("extra2");
+    extra->setIncludeGeom("/scene6");
+    REQUIRE(!top->matchesGeomString("/scene6/sphere"));
+    extra->setName("extra");
+    REQUIRE(top->matchesGeomString("/scene6/sphere"));
+    doc->addNodeGraph()->addNode("constant");
+    REQUIRE(top->matchesGeomString("/scene6/sphere"));
+    doc->setGeomPrefix("/root");
+    REQUIRE(top->matchesGeomString("/root/scene6/sphere"));
+    doc->removeAttribute(mx::Element::GEOM_PREFIX_ATTRIBUTE);
+    right->setIncludeCollection(base);
+
+    // Create and test an include cycle.
+    base->setIncludeCollection(top);
+    REQUIRE(top->hasIncludeCycle());
+    REQUIRE(base->hasIncludeCycle());
+    REQUIRE(left->matchesGeomString("/scene3/sphere"));
+    REQUIRE_THROWS_AS(top->matchesGeomString("/scene5"), mx::ExceptionFoundCycle&);
+    REQUIRE_THROWS_AS(top->matchesGeomStrings(geoms, 0), mx::ExceptionFoundCycle&);
+    REQUIRE(!doc->validate());
+}
+
 TEST_CASE("GeomPropDef", "[geom]")
 {
     mx::DocumentPtr doc = mx::createDocument();
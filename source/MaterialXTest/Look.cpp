@@ -37,6 +37,23 @@ TEST_CASE("Look", "[look]")
     REQUIRE(material->getGeometryBindings("/robot2/right_arm").size() == 1);
     REQUIRE(material->getGeometryBindings("/robot2/left_arm").size() == 0);
 
+    // Bindings of other materials are not evaluated, even when their
+    // collections contain an include cycle.
+    mx::MaterialPtr material2 = doc->addMaterial();
+    mx::CollectionPtr cycle1 = doc->addCollection();
+    mx::CollectionPtr cycle2 = doc->addCollection();
+    cycle1->setIncludeCollection(cycle2);
+    cycle2->setIncludeCollection(cycle1);
+    mx::MaterialAssignPtr matAssign3 = look->addMaterialAssign("matAssign3", material2->getName());
+    matAssign3->setCollection(cycle1);
+    REQUIRE_THROWS_AS(material2->getGeometryBindings("/robot2"), mx::ExceptionFoundCycle&);
+    REQUIRE(material->getGeometryBindings("/robot2").size() == 1);
+    REQUIRE(material->getGeometryBindings("/robot1").size() == 1);
+    look->removeMaterialAssign(matAssign3->getName());
+    doc->removeCollection(cycle1->getName());
+    doc->removeCollection(cycle2->getName());
+    doc->removeMaterial(material2->getName());
+
     // Create a property assignment.
     mx::PropertyAssignPtr propertyAssign = look->addPropertyAssign("twosided");
     propertyAssign->setGeom("/robot1");
@@ -89,3 +106,96 @@ TEST_CASE("Look", "[look]")
     REQUIRE(look2->getActivePropertySetAssigns().empty());
     REQUIRE(look2->getActiveVisibilities().empty());
 }
+
+TEST_CASE("Look resolver", "[look]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::MaterialPtr metal = doc->addMaterial("metal");
+    mx::MaterialPtr paint = doc->addMaterial("paint");
+    mx::MaterialPtr rubber = doc->addMaterial("rubber");
+
+    // Create a base look with material, property and visibility assignments.
+    mx::LookPtr baseLook = doc->addLook("baseLook");
+    mx::MaterialAssignPtr metalAssign = baseLook->addMaterialAssign("metalAssign", metal->getName());
+    metalAssign->setGeom("/robot1");
+    mx::VariantAssignPtr metalVariant = metalAssign->addVariantAssign("metalVariant");
+    mx::CollectionPtr wheels = doc->addCollection("wheels");
+    wheels->setIncludeGeom("/robot1/wheels, /robot2/wheels");
+    mx::MaterialAssignPtr rubberAssign = baseLook->addMaterialAssign("rubberAssign", rubber->getName());
+    rubberAssign->setCollection(wheels);
+    mx::PropertyAssignPtr twosided = baseLook->addPropertyAssign("twosided");
+    twosided->setGeom("/robot1/body");
+    mx::VisibilityPtr visibility = baseLook->addVisibility("visibility");
+    visibility->setGeom("/");
+    mx::VariantAssignPtr lookVariant = baseLook->addVariantAssign("lookVariant");
+
+    // Create a derived look with an exclusive assignment.
+    mx::LookPtr look = doc->addLook("look");
+    look->setInheritsFrom(baseLook);
+    mx::MaterialAssignPtr paintAssign = look->addMaterialAssign("paintAssign", paint->getName());
+    paintAssign->setGeom("/robot1/body, /robot2");
+    paintAssign->setExclusive(true);
+    mx::PropertySetAssignPtr propertySetAssign = look->addPropertySetAssign("propertySetAssign");
+    propertySetAssign->setGeom("/robot2");
+    mx::VisibilityPtr shadowVisibility = look->addVisibility("shadowVisibility");
+    shadowVisibility->setGeom("/robot2/wheels");
+    shadowVisibility->setViewerGeom("/lights/key");
+    shadowVisibility->setVisibilityType("shadow");
+    mx::VisibilityPtr robot2Visibility = look->addVisibility("robot2Visibility");
+    robot2Visibility->setGeom("/robot2");
+    robot2Visibility->setVisible(true);
+
+    // Resolve individual geometries.
+    mx::LookResolver resolver(look);
+    mx::LookAssignments body = resolver.resolve("/robot1/body");
+    REQUIRE(body.material == paint);
+    REQUIRE(body.materialAssigns.size() == 1);
+    REQUIRE(body.variantAssigns.size() == 1);
+    REQUIRE(body.variantAssigns[0] == lookVariant);
+    REQUIRE(body.propertyAssigns.size() == 1);
+    REQUIRE(body.propertySetAssigns.empty());
+    REQUIRE(body.visibilities.size() == 1);
+    mx::LookAssignments wheel = resolver.resolve("/robot1/wheels/front");
+    REQUIRE(wheel.material == metal);
+    REQUIRE(wheel.materialAssigns.size() == 2);
+    REQUIRE(wheel.materialAssigns[1] == rubberAssign);
+    REQUIRE(wheel.variantAssigns.size() == 2);
+    REQUIRE(wheel.variantAssigns[0] == metalVariant);
+    REQUIRE(wheel.propertyAssigns.empty());
+    mx::LookAssignments robot2 = resolver.resolve("/robot2/wheels");
+    REQUIRE(robot2.material == paint);
+    REQUIRE(robot2.propertySetAssigns.size() == 1);
+
+    // Resolve visibility, where the derived look overrides the base look.
+    REQUIRE(!body.isVisible());
+    REQUIRE(body.resolvedVisibilities.size() == 1);
+    REQUIRE(robot2.visibilities.size() == 3);
+    REQUIRE(robot2.resolvedVisibilities.size() == 2);
+    REQUIRE(robot2.resolvedVisibilities[0].visibility == shadowVisibility);
+    REQUIRE(robot2.resolvedVisibilities[1].visibility == robot2Visibility);
+    REQUIRE(robot2.isVisible());
+    REQUIRE(robot2.isVisible("/lights/fill", "shadow"));
+    REQUIRE(!robot2.isVisible("/lights/key", "shadow"));
+    REQUIRE(robot2.isVisible("/lights/key", "camera"));
+    mx::LookAssignments empty = resolver.resolve("");
+    REQUIRE(!empty.material);
+    REQUIRE(empty.visibilities.empty());
+
+    // Resolve a batch of geometries.
+    mx::StringVec geoms = { "/robot1/body", "/robot1/wheels/front", "/robot2/wheels", "/robot3", "" };
+    std::vector<mx::LookAssignments> results = resolver.resolve(geoms, 0);
+    REQUIRE(results.size() == geoms.size());
+    for (size_t i = 0; i < geoms.size(); i++)
+    {
+        mx::LookAssignments expected = resolver.resolve(geoms[i]);
+        REQUIRE(results[i].material == expected.material);
+        REQUIRE(results[i].materialAssigns == expected.materialAssigns);
+        REQUIRE(results[i].variantAssigns == expected.variantAssigns);
+        REQUIRE(results[i].propertyAssigns == expected.propertyAssigns);
+        REQUIRE(results[i].propertySetAssigns == expected.propertySetAssigns);
+        REQUIRE(results[i].visibilities == expected.visibilities);
+        REQUIRE(results[i].isVisible() == expected.isVisible());
+    }
+    REQUIRE(!results[3].material);
+    REQUIRE(results[3].visibilities.size() == 1);
+}
@@ -125,6 +125,28 @@ TEST_CASE("Node", "[node]")
     REQUIRE(constant->getDownstreamPorts().empty());
     REQUIRE(image->getDownstreamPorts().empty());
 
+    // Downstream ports are scoped to the graph of each node.
+    mx::NodeGraphPtr graph1 = doc->addNodeGraph();
+    mx::NodeGraphPtr graph2 = doc->addNodeGraph();
+    mx::NodePtr node1 = graph1->addNode("constant", "shared");
+    mx::NodePtr node2 = graph2->addNode("constant", "shared");
+    mx::NodePtr add1 = graph1->addNode("add");
+    add1->setConnectedNode("in1", node1);
+    add1->setConnectedNode("in2", node1);
+    mx::OutputPtr graphOutput = graph2->addOutput();
+    graphOutput->setConnectedNode(node2);
+    REQUIRE(node1->getDownstreamPorts().size() == 2);
+    REQUIRE(node2->getDownstreamPorts().size() == 1);
+    REQUIRE(node2->getDownstreamPorts()[0] == graphOutput);
+    node2->setName("renamed");
+    REQUIRE(node2->getDownstreamPorts().empty());
+    graphOutput->setNodeName("renamed");
+    REQUIRE(node2->getDownstreamPorts()[0] == graphOutput);
+    add1->removeInput("in2");
+    REQUIRE(node1->getDownstreamPorts().size() == 1);
+    doc->removeNodeGraph(graph1->getName());
+    doc->removeNodeGraph(graph2->getName());
+
     // Remove nodes and outputs.
     doc->removeNode(image->getName());
     doc->removeNode(constant->getName());
@@ -135,6 +157,107 @@ TEST_CASE("Node", "[node]")
     REQUIRE(doc->getOutputs().empty());
 }
 
+TEST_CASE("Active interface elements", "[node]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+
+    // Create a nodedef that inherits from a base nodedef.
+    mx::NodeDefPtr baseDef = doc->addNodeDef("ND_base", "color3", "base");
+    baseDef->setParameterValue("roughness", 0.5f);
+    baseDef->setInputValue("base", mx::Color3(1.0f));
+    mx::NodeDefPtr derivedDef = doc->addNodeDef("ND_derived", "color3", "derived");
+    derivedDef->setInputValue("base", mx::Color3(0.5f));
+    derivedDef->setInputValue("coat", 1.0f);
+    derivedDef->setInheritsFrom(baseDef);
+    REQUIRE(derivedDef->getActiveInputs().size() == 3);
+    REQUIRE(derivedDef->getActiveInput("base") == derivedDef->getInput("base"));
+    REQUIRE(derivedDef->getActiveParameter("roughness") == baseDef->getParameter("roughness"));
+    REQUIRE(derivedDef->getActiveValueElements().size() == 4);
+    REQUIRE(derivedDef->getActiveValueElement("coat") == derivedDef->getInput("coat"));
+    REQUIRE(!derivedDef->getActiveOutput("out"));
+
+    // Edits to the base nodedef are reflected in the derived nodedef.
+    mx::OutputPtr output = baseDef->addOutput("out", "color3");
+    REQUIRE(derivedDef->getActiveOutput("out") == output);
+    baseDef->removeParameter("roughness");
+    REQUIRE(!derivedDef->getActiveParameter("roughness"));
+    REQUIRE(derivedDef->getActiveParameters().empty());
+
+    // Edits to the derived nodedef and its inheritance are reflected.
+    derivedDef->getInput("coat")->setName("clearcoat");
+    REQUIRE(!derivedDef->getActiveInput("coat"));
+    REQUIRE(derivedDef->getActiveInput("clearcoat"));
+    derivedDef->removeInput("base");
+    REQUIRE(derivedDef->getActiveInput("base") == baseDef->getInput("base"));
+    derivedDef->setInheritsFrom(nullptr);
+    REQUIRE(derivedDef->getActiveInputs().size() == 1);
+    REQUIRE(!derivedDef->getActiveOutput("out"));
+
+    // Replacing an input with an identical input is reflected.
+    derivedDef->removeInput("clearcoat");
+    mx::InputPtr clearcoat = derivedDef->addInput("clearcoat", "float");
+    clearcoat->setValue(1.0f);
+    REQUIRE(derivedDef->getActiveInput("clearcoat") == clearcoat);
+    REQUIRE(derivedDef->getActiveInputs()[0] == clearcoat);
+
+    // Renaming the base nodedef breaks the inheritance reference.
+    derivedDef->setInheritsFrom(baseDef);
+    REQUIRE(derivedDef->getActiveOutput("out") == output);
+    baseDef->setName("ND_base2");
+    REQUIRE(!derivedDef->getActiveOutput("out"));
+
+    // Verify that inheritance cycles are detected.
+    derivedDef->setInheritsFrom(baseDef);
+    baseDef->setInheritsFrom(derivedDef);
+    REQUIRE_THROWS_AS(derivedDef->getActiveInputs(), mx::ExceptionFoundCycle&);
+}
+
+TEST_CASE("NodeDef resolution", "[node]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+
+    // Create overloaded nodedefs for a single category.
+    mx::NodeDefPtr floatDef = doc->addNodeDef("ND_blend_float", "float", "blend");
+    floatDef->addInput("in", "float");
+    mx::NodeDefPtr colorDef = doc->addNodeDef("ND_blend_color3", "color3", "blend");
+    colorDef->addInput("in", "color3");
+
+    // Resolve nodes to their matching overloads.
+    mx::NodePtr floatNode = doc->addNode("blend", "node1", "float");
+    floatNode->setInputValue("in", 0.5f);
+    mx::NodePtr colorNode = doc->addNode("blend", "node2", "color3");
+    colorNode->setInputValue("in", mx::Color3(0.5f));
+    REQUIRE(floatNode->getNodeDef() == floatDef);
+    REQUIRE(colorNode->getNodeDef() == colorDef);
+    REQUIRE(floatNode->getNodeDef() == floatDef);
+
+    // Edits to a node are reflected in its resolved nodedef.
+    floatNode->setType("color3");
+    REQUIRE(!floatNode->getNodeDef());
+    floatNode->setInputValue("in", mx::Color3(0.25f));
+    REQUIRE(floatNode->getNodeDef() == colorDef);
+    floatNode->setType("float");
+    floatNode->setInputValue("in", 0.25f);
+    REQUIRE(floatNode->getNodeDef() == floatDef);
+
+    // Edits to nodedefs are reflected in resolved nodedefs.
+    floatDef->getInput("in")->setType("vector2");
+    REQUIRE(!floatNode->getNodeDef());
+    floatDef->getInput("in")->setType("float");
+    REQUIRE(floatNode->getNodeDef() == floatDef);
+    doc->removeNodeDef(floatDef->getName());
+    REQUIRE(!floatNode->getNodeDef());
+    mx::NodeDefPtr floatDef2 = doc->addNodeDef("ND_blend_float2", "float", "blend");
+    floatDef2->addInput("in", "float");
+    REQUIRE(floatNode->getNodeDef() == floatDef2);
+
+    // Resolve nodedefs by target.
+    floatDef2->setTarget("genosl");
+    REQUIRE(floatNode->getNodeDef("genosl") == floatDef2);
+    REQUIRE(!floatNode->getNodeDef("genglsl"));
+    REQUIRE(colorNode->getNodeDef("genglsl") == colorDef);
+}
+
 TEST_CASE("Flatten", "[nodegraph]")
 {
     std::string searchPath = "resources/Materials/Examples" + mx::PATH_LIST_SEPARATOR + "libraries/stdlib";
@@ -25,7 +25,8 @@ TEST_CASE("Observer", "[observer]")
             _copyContentCount(0),
             _clearContentCount(0),
             _readCount(0),
-            _writeCount(0)
+            _writeCount(0),
+            _bulkLoadCount(0)
         {
         }
 
@@ -39,6 +40,7 @@ TEST_CASE("Observer", "[observer]")
         void onClearContent(mx::ElementPtr elem) override { _clearContentCount++; }
         void onRead() override { _readCount++; }
         void onWrite() override { _writeCount++; }
+        void onBulkLoad() override { _bulkLoadCount++; }
 
         void clear()
         {
@@ -52,6 +54,7 @@ TEST_CASE("Observer", "[observer]")
             _clearContentCount = 0;
             _readCount = 0;
             _writeCount = 0;
+            _bulkLoadCount = 0;
         }
 
         void verifyCountsPreWrite()
@@ -82,6 +85,21 @@ TEST_CASE("Observer", "[observer]")
             REQUIRE(_writeCount == 1);
         }
 
+        void verifyCountsBulkLoad()
+        {
+            REQUIRE(_beginUpdateCount == 1);
+            REQUIRE(_endUpdateCount == 1);
+            REQUIRE(_addElementCount == 0);
+            REQUIRE(_setAttributeCount == 0);
+            REQUIRE(_removeElementCount == 0);
+            REQUIRE(_removeAttributeCount == 0);
+            REQUIRE(_copyContentCount == 0);
+            REQUIRE(_clearContentCount == 0);
+            REQUIRE(_readCount == 1);
+            REQUIRE(_writeCount == 0);
+            REQUIRE(_bulkLoadCount == 1);
+        }
+
         void verifyCountsDisabled()
         {
             REQUIRE(_beginUpdateCount == 0);
@@ -108,6 +126,7 @@ TEST_CASE("Observer", "[observer]")
         unsigned int _clearContentCount;
         unsigned int _readCount;
         unsigned int _writeCount;
+        unsigned int _bulkLoadCount;
     };
 
     // Create an observed document.
@@ -153,4 +172,17 @@ TEST_CASE("Observer", "[observer]")
     doc->initialize();
     mx::readFromXmlString(doc, xmlString);
     testObserver->verifyCountsDisabled();
+
+    // Check bulk loading, where per-element callbacks are replaced by a single
+    // bulk load notification.
+    doc->enableCallbacks();
+    doc->initialize();
+    testObserver->clear();
+    mx::XmlReadOptions readOptions;
+    readOptions.bulkLoad = true;
+    mx::readFromXmlString(doc, xmlString, &readOptions);
+    testObserver->verifyCountsBulkLoad();
+    REQUIRE(!doc->isBulkLoading());
+    REQUIRE(doc->getNodeDef("ND_simpleSrf"));
+    REQUIRE(doc->getMatchingNodeDefs("simpleSrf").size() == 1);
 }
@@ -159,6 +159,21 @@ TEST_CASE("Traversal", "[traversal]")
     multiply->setConnectedNode("in2", mix);
     REQUIRE(output->hasUpstreamCycle());
     REQUIRE(!doc->validate());
+    REQUIRE(nodeGraph->hasUpstreamCycle(multiply));
+    REQUIRE(nodeGraph->hasUpstreamCycle(mix));
+    REQUIRE(!nodeGraph->hasUpstreamCycle(image1));
+    REQUIRE(!nodeGraph->hasUpstreamCycle(contrast));
+
+    // Replace a node within the cycle with an identical node.
+    int mixIndex = nodeGraph->getChildIndex(mix->getName());
+    nodeGraph->removeNode(mix->getName());
+    mx::NodePtr mixCopy = nodeGraph->addNode(mix->getCategory(), mix->getName(), mix->getType());
+    mixCopy->copyContentFrom(mix);
+    nodeGraph->setChildIndex(mixCopy->getName(), mixIndex);
+    REQUIRE(nodeGraph->hasUpstreamCycle(mixCopy));
+    REQUIRE(!nodeGraph->hasUpstreamCycle(mix));
+    REQUIRE(output->hasUpstreamCycle());
+    mix = mixCopy;
     multiply->setConnectedNode("in2", constant);
     REQUIRE(!output->hasUpstreamCycle());
     REQUIRE(doc->validate());
@@ -167,7 +182,42 @@ TEST_CASE("Traversal", "[traversal]")
     contrast->setConnectedNode("in", contrast);
     REQUIRE(output->hasUpstreamCycle());
     REQUIRE(!doc->validate());
+    REQUIRE(nodeGraph->hasUpstreamCycle(contrast));
+    REQUIRE(!nodeGraph->hasUpstreamCycle(image2));
     contrast->setConnectedNode("in", image2);
     REQUIRE(!output->hasUpstreamCycle());
     REQUIRE(doc->validate());
+
+    // Traverse a long chain of nodes, each with a second constant input,
+    // then create and detect a cycle spanning the chain.
+    const size_t CHAIN_LENGTH = 200;
+    mx::NodeGraphPtr chainGraph = doc->addNodeGraph();
+    mx::NodePtr first = chainGraph->addNode("constant");
+    mx::NodePtr last = first;
+    for (size_t i = 1; i < CHAIN_LENGTH; i++)
+    {
+        mx::NodePtr next = chainGraph->addNode("add");
+        next->setConnectedNode("in1", last);
+        next->setConnectedNode("in2", chainGraph->addNode("constant"));
+        last = next;
+    }
+    mx::OutputPtr chainOutput = chainGraph->addOutput();
+    chainOutput->setConnectedNode(last);
+    nodeCount = 0;
+    maxNodeDepth = 0;
+    for (mx::GraphIterator it = chainOutput->traverseGraph().begin(); it != mx::GraphIterator::end(); ++it)
+    {
+        if (it.getUpstreamElement()->isA<mx::Node>())
+        {
+            nodeCount++;
+        }
+        maxNodeDepth = std::max(maxNodeDepth, it.getNodeDepth());
+    }
+    REQUIRE(nodeCount == CHAIN_LENGTH * 2 - 1);
+    REQUIRE(maxNodeDepth == CHAIN_LENGTH);
+    REQUIRE(!chainOutput->hasUpstreamCycle());
+    first->setConnectedNode("in", last);
+    REQUIRE(chainOutput->hasUpstreamCycle());
+    first->removeInput("in");
+    REQUIRE(!chainOutput->hasUpstreamCycle());
 }
@@ -44,6 +44,17 @@ TEST_CASE("Vectors", "[types]")
     REQUIRE(v3.getNormalized().getMagnitude() == 1);
     REQUIRE(v1.dot(v2) == 28);
     REQUIRE(v1.cross(v2) == mx::Vector3());
+
+    // Four-component operators
+    mx::Vector4 v4(1, 2, 3, 4);
+    mx::Vector4 v5(2, 4, 6, 8);
+    REQUIRE(v5 + v4 == mx::Vector4(3, 6, 9, 12));
+    REQUIRE(v5 - v4 == v4);
+    REQUIRE(v5 * v4 == mx::Vector4(2, 8, 18, 32));
+    REQUIRE(v5 / v4 == mx::Vector4(2));
+    REQUIRE(v4 * 2 == v5);
+    REQUIRE(v5 / 2 == v4);
+    REQUIRE(mx::Color4(2, 4, 6, 8) / mx::Color4(1, 2, 3, 4) == mx::Vector4(2));
 }
 
 TEST_CASE("Matrices", "[types]")
@@ -122,4 +133,46 @@ TEST_CASE("Matrices", "[types]")
     REQUIRE((rotX * rotY).isEquivalent(mx::Matrix44::createScale({-1, -1, 1}), EPSILON));
     REQUIRE((rotX * rotZ).isEquivalent(mx::Matrix44::createScale({-1, 1, -1}), EPSILON));
     REQUIRE((rotY * rotZ).isEquivalent(mx::Matrix44::createScale({1, -1, -1}), EPSILON));
+
+    // General inverse
+    mx::Matrix33 mat33(2, 1, 0,
+                       1, 3, 1,
+                       0, 1, 4);
+    mx::Matrix44 mat44 = rotX * mx::Matrix44::createRotationY(PI / 3) * scale * trans;
+    mat44[0][3] = 0.5f;
+    REQUIRE((mat33 * mat33.getInverse()).isEquivalent(mx::Matrix33::IDENTITY, EPSILON));
+    REQUIRE((mat44 * mat44.getInverse()).isEquivalent(mx::Matrix44::IDENTITY, EPSILON));
+    REQUIRE((mat44.getInverse().getDeterminant() * mat44.getDeterminant()) == Approx(1.0f));
+    REQUIRE(mat44.getTranspose().getTranspose() == mat44);
+
+    // Vector transformations
+    REQUIRE(trans.transformPoint(mx::Vector3(1)) == mx::Vector3(2, 3, 4));
+    REQUIRE(trans.transformVector(mx::Vector3(1)) == mx::Vector3(1));
+    REQUIRE(prod1.transformPoint(mx::Vector3(1)) == mx::Vector3(4, 6, 8));
+    REQUIRE(mx::Matrix44::createScale(mx::Vector3(1, 2, 4)).transformNormal(mx::Vector3(1)) ==
+            mx::Vector3(1.0f, 0.5f, 0.25f));
+
+    // Batch transformations over a strided array, with the fourth component
+    // of each element left untouched.
+    const size_t STRIDE = 4;
+    const size_t COUNT = 40000;
+    std::vector<float> points(COUNT * STRIDE);
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        points[i] = (float) (i % 97) - 48.0f;
+    }
+    std::vector<float> vectors(points), normals(points);
+    mat44.transformPoints(points.data(), COUNT, STRIDE, 0);
+    mat44.transformVectors(vectors.data(), COUNT, STRIDE);
+    mat44.transformNormals(normals.data(), COUNT, STRIDE, 4);
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        size_t index = i * STRIDE;
+        mx::Vector3 v((float) (index % 97) - 48.0f, (float) ((index + 1) % 97) - 48.0f, (float) ((index + 2) % 97) - 48.0f);
+        REQUIRE(mx::Vector3(&points[index], &points[index] + 3) == mat44.transformPoint(v));
+        REQUIRE(mx::Vector3(&vectors[index], &vectors[index] + 3) == mat44.transformVector(v));
+        REQUIRE(mx::Vector3(&normals[index], &normals[index] + 3) == mat44.transformNormal(v));
+        REQUIRE(points[index + 3] == (float) ((index + 3) % 97) - 48.0f);
+    }
+    REQUIRE_THROWS_AS(mat44.transformPoints(points.data(), COUNT, 2), mx::Exception&);
 }
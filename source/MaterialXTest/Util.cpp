@@ -28,6 +28,14 @@ TEST_CASE("String utilities", "[util]")
 
     REQUIRE(mx::splitString("robot1, robot2", ", ") == (std::vector<std::string>{"robot1", "robot2"}));
     REQUIRE(mx::splitString("[one...two...three]", "[.]") == (std::vector<std::string>{"one", "two", "three"}));
+
+    REQUIRE(*mx::findInternedString("nodename") == "nodename");
+    REQUIRE(mx::findInternedString("nodename") == mx::findInternedString(std::string("node") + "name"));
+    REQUIRE(mx::findInternedString("testName") == nullptr);
+    REQUIRE(mx::InternedString("type") == mx::InternedString("type"));
+    REQUIRE(mx::InternedString("testName") == mx::InternedString("testName"));
+    REQUIRE(mx::InternedString("testName") != mx::InternedString("type"));
+    REQUIRE(mx::InternedString("testName").str() == "testName");
 }
 
 TEST_CASE("Print utilities", "[util]")
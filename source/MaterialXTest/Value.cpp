@@ -31,6 +31,12 @@ template<class T> void testTypedValue(const T& v1, const T& v2)
     REQUIRE(value2->copy()->asA<T>() == value2->asA<T>());
     REQUIRE(value1->asA<T>() != value2->asA<T>());
 
+    // Copies with independent data
+    mx::ValuePtr copy1 = value1->copy();
+    std::static_pointer_cast<mx::TypedValue<T>>(copy1)->setData(v2);
+    REQUIRE(copy1->asA<T>() == v2);
+    REQUIRE(value1->asA<T>() == v1);
+
     // Serialization and deserialization
     mx::ValuePtr newValue0 = mx::TypedValue<T>::createFromString(value0->getValueString());
     mx::ValuePtr newValue1 = mx::TypedValue<T>::createFromString(value1->getValueString());
@@ -73,12 +79,20 @@ TEST_CASE("Value strings", "[value]")
     REQUIRE(mx::fromValueString<bool>("false") == false);
     REQUIRE(mx::fromValueString<mx::Color3>("1, 1, 1") == mx::Color3(1.0f));
     REQUIRE(mx::fromValueString<std::string>("text") == "text");
+    REQUIRE(mx::fromValueString<int>("-12") == -12);
+    REQUIRE(mx::fromValueString<float>("1.5e2") == 150.0f);
+    REQUIRE(mx::fromValueString<mx::Matrix33>("1, 2, 3, 4, 5, 6, 7, 8, 9")[1][0] == 4.0f);
+    REQUIRE(mx::fromValueString<std::vector<float>>("0.5,1.5  2.5") == std::vector<float>({0.5f, 1.5f, 2.5f}));
+    REQUIRE(mx::toValueString(std::vector<float>({0.5f, 1.25f})) == "0.5, 1.25");
+    REQUIRE(mx::toValueString(std::vector<int>({-1, 2})) == "-1, 2");
 
     // Verify that invalid conversions throw exceptions.
     REQUIRE_THROWS_AS(mx::fromValueString<int>("text"), mx::ExceptionTypeError&);
     REQUIRE_THROWS_AS(mx::fromValueString<float>("text"), mx::ExceptionTypeError&);
     REQUIRE_THROWS_AS(mx::fromValueString<bool>("1"), mx::ExceptionTypeError&);
     REQUIRE_THROWS_AS(mx::fromValueString<mx::Color3>("1"), mx::ExceptionTypeError&);
+    REQUIRE_THROWS_AS(mx::fromValueString<mx::Color3>("1, 1, 1, 1"), mx::ExceptionTypeError&);
+    REQUIRE_THROWS_AS(mx::fromValueString<int>("99999999999"), mx::ExceptionTypeError&);
 }
 
 TEST_CASE("Typed values", "[value]")
@@ -119,4 +133,18 @@ TEST_CASE("Typed values", "[value]")
     // Alias types
     testTypedValue<long>(1l, 2l);
     testTypedValue<double>(1.0, 2.0);
+
+    // Non-empty string and array data are shared between copies.
+    mx::ValuePtr stringValue = mx::Value::createValue(std::string("text"));
+    mx::ValuePtr stringCopy = stringValue->copy();
+    REQUIRE(stringCopy->asA<std::string>() == "text");
+    REQUIRE(&stringValue->copy()->asA<std::string>() == &stringCopy->asA<std::string>());
+    REQUIRE(&stringCopy->copy()->asA<std::string>() == &stringCopy->asA<std::string>());
+    std::static_pointer_cast<mx::TypedValue<std::string>>(stringCopy)->setData("edited");
+    REQUIRE(stringValue->asA<std::string>() == "text");
+    REQUIRE(stringValue->copy()->asA<std::string>() == "text");
+    mx::ValuePtr emptyValue = mx::Value::createValue(std::string());
+    REQUIRE(&emptyValue->copy()->asA<std::string>() != &emptyValue->copy()->asA<std::string>());
+    mx::ValuePtr floatValue = mx::Value::createValue(1.0f);
+    REQUIRE(&floatValue->copy()->asA<float>() != &floatValue->asA<float>());
 }
@@ -19,6 +19,9 @@ void bindPyDocument(py::module& mod)
         .def("copy", &mx::Document::copy)
         .def("importLibrary", &mx::Document::importLibrary, 
             py::arg("library"), py::arg("copyOptions") = (const mx::CopyOptions*) nullptr)
+        .def("beginBulkLoad", &mx::Document::beginBulkLoad)
+        .def("endBulkLoad", &mx::Document::endBulkLoad)
+        .def("isBulkLoading", &mx::Document::isBulkLoading)
         .def("addNodeGraph", &mx::Document::addNodeGraph,
             py::arg("name") = mx::EMPTY_STRING)
         .def("getNodeGraph", &mx::Document::getNodeGraph)
@@ -37,6 +40,10 @@ void bindPyDocument(py::module& mod)
         .def("removeGeomInfo", &mx::Document::removeGeomInfo)
         .def("getGeomAttrValue", &mx::Document::getGeomAttrValue,
             py::arg("geomAttrName"), py::arg("geom") = mx::UNIVERSAL_GEOM_NAME)
+        .def("getGeomPathIndex", [](mx::Document& doc)
+            {
+                return std::const_pointer_cast<mx::GeomPathIndex>(doc.getGeomPathIndex());
+            })
         .def("addLook", &mx::Document::addLook,
             py::arg("name") = mx::EMPTY_STRING)
         .def("getLook", &mx::Document::getLook)
@@ -74,6 +81,12 @@ void bindPyDocument(py::module& mod)
         .def("getImplementation", &mx::Document::getImplementation)
         .def("getImplementations", &mx::Document::getImplementations)
         .def("removeImplementation", &mx::Document::removeImplementation)
+        .def("validateParallel", [](mx::Document& doc, unsigned int threadCount)
+            {
+                std::string message;
+                bool res = doc.validateParallel(&message, threadCount);
+                return std::pair<bool, std::string>(res, message);
+            }, py::arg("threadCount") = 0)
         .def("upgradeVersion", &mx::Document::upgradeVersion)
         .def("setColorManagementSystem", &mx::Document::setColorManagementSystem)
         .def("hasColorManagementSystem", &mx::Document::hasColorManagementSystem)
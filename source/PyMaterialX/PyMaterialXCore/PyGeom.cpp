@@ -83,7 +83,18 @@ void bindPyGeom(py::module& mod)
         .def("getIncludeCollections", &mx::Collection::getIncludeCollections)
         .def("hasIncludeCycle", &mx::Collection::hasIncludeCycle)
         .def("matchesGeomString", &mx::Collection::matchesGeomString)
+        .def("matchesGeomStrings", &mx::Collection::matchesGeomStrings,
+            py::arg("geoms"), py::arg("threadCount") = 1)
         .def_readonly_static("CATEGORY", &mx::Collection::CATEGORY);
 
+    py::class_<mx::GeomPathIndex, mx::GeomPathIndexPtr>(mod, "GeomPathIndex")
+        .def(py::init<>())
+        .def("addElement", &mx::GeomPathIndex::addElement,
+            py::arg("elem"), py::arg("geom"), py::arg("collection") = mx::ConstCollectionPtr())
+        .def("getElementCount", &mx::GeomPathIndex::getElementCount)
+        .def("getMatchingElements", (std::vector<mx::ElementPtr> (mx::GeomPathIndex::*)(const std::string&) const) &mx::GeomPathIndex::getMatchingElements)
+        .def("getMatchingElements", (std::vector<std::vector<mx::ElementPtr>> (mx::GeomPathIndex::*)(const mx::StringVec&, unsigned int) const) &mx::GeomPathIndex::getMatchingElements,
+            py::arg("geoms"), py::arg("threadCount") = 1);
+
     mod.def("geomStringsMatch", &mx::geomStringsMatch);
 }
@@ -70,4 +70,32 @@ void bindPyLook(py::module& mod)
         .def("setVisible", &mx::Visibility::setVisible)
         .def("getVisible", &mx::Visibility::getVisible)
         .def_readonly_static("CATEGORY", &mx::Visibility::CATEGORY);
+
+    py::class_<mx::ResolvedVisibility>(mod, "ResolvedVisibility")
+        .def_readonly("visibilityType", &mx::ResolvedVisibility::visibilityType)
+        .def_readonly("viewerGeom", &mx::ResolvedVisibility::viewerGeom)
+        .def_readonly("viewerCollection", &mx::ResolvedVisibility::viewerCollection)
+        .def_readonly("visible", &mx::ResolvedVisibility::visible)
+        .def_readonly("visibility", &mx::ResolvedVisibility::visibility);
+
+    py::class_<mx::LookAssignments>(mod, "LookAssignments")
+        .def_readonly("material", &mx::LookAssignments::material)
+        .def_readonly("materialAssigns", &mx::LookAssignments::materialAssigns)
+        .def_readonly("variantAssigns", &mx::LookAssignments::variantAssigns)
+        .def_readonly("propertyAssigns", &mx::LookAssignments::propertyAssigns)
+        .def_readonly("propertySetAssigns", &mx::LookAssignments::propertySetAssigns)
+        .def_readonly("visibilities", &mx::LookAssignments::visibilities)
+        .def_readonly("resolvedVisibilities", &mx::LookAssignments::resolvedVisibilities)
+        .def("isVisible", &mx::LookAssignments::isVisible,
+            py::arg("viewerGeom") = mx::EMPTY_STRING, py::arg("visibilityType") = mx::EMPTY_STRING);
+
+    py::class_<mx::LookResolver, mx::LookResolverPtr>(mod, "LookResolver")
+        .def(py::init<mx::ConstLookPtr>())
+        .def("getLook", [](mx::LookResolver& resolver)
+            {
+                return std::const_pointer_cast<mx::Look>(resolver.getLook());
+            })
+        .def("resolve", (mx::LookAssignments (mx::LookResolver::*)(const std::string&) const) &mx::LookResolver::resolve)
+        .def("resolve", (std::vector<mx::LookAssignments> (mx::LookResolver::*)(const mx::StringVec&, unsigned int) const) &mx::LookResolver::resolve,
+            py::arg("geoms"), py::arg("threadCount") = 1);
 }
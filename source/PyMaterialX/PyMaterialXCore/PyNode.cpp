@@ -37,6 +37,7 @@ void bindPyNode(py::module& mod)
         .def("flattenSubgraphs", &mx::NodeGraph::flattenSubgraphs,
             py::arg("target") = mx::EMPTY_STRING)
         .def("topologicalSort", &mx::NodeGraph::topologicalSort)
+        .def("hasUpstreamCycle", &mx::NodeGraph::hasUpstreamCycle)
         .def("asStringDot", &mx::NodeGraph::asStringDot);
 
     py::class_<mx::NodeGraph, mx::NodeGraphPtr, mx::GraphElement>(mod, "NodeGraph")
@@ -21,6 +21,7 @@ void bindPyObserver(py::module& mod)
         .def("onClearContent", &mx::Observer::onClearContent)
         .def("onRead", &mx::Observer::onRead)
         .def("onWrite", &mx::Observer::onWrite)
+        .def("onBulkLoad", &mx::Observer::onBulkLoad)
         .def("onBeginUpdate", &mx::Observer::onBeginUpdate)
         .def("onEndUpdate", &mx::Observer::onEndUpdate);
 }
@@ -16,6 +16,21 @@ namespace mx = MaterialX;
 
 using IndexPair = std::pair<size_t, size_t>;
 
+namespace {
+
+// Native indexing operators are unchecked, so validate indices here and raise
+// IndexError, which Python also relies upon to terminate iteration.
+size_t checkIndex(size_t i, size_t n)
+{
+    if (i >= n)
+    {
+        throw py::index_error();
+    }
+    return i;
+}
+
+} // anonymous namespace
+
 #define BIND_VECTOR_SUBCLASS(V, N)                      \
 .def(py::init<>())                                      \
 .def(py::init<float>())                                 \
@@ -33,9 +48,9 @@ using IndexPair = std::pair<size_t, size_t>;
 .def("getNormalized", &V::getNormalized)                \
 .def("dot", &V::dot)                                    \
 .def("__getitem__", [](V& v, size_t i)                  \
-    { return v[i]; } )                                  \
+    { return v[checkIndex(i, N)]; } )                   \
 .def("__setitem__", [](V& v, size_t i, float f)         \
-    { v[i] = f; } )                                     \
+    { v[checkIndex(i, N)] = f; } )                      \
 .def("__str__", [](const V& v)                          \
     { return mx::toValueString(v); })                   \
 .def("copy", [](const V& v) { return V(v); })           \
@@ -53,9 +68,11 @@ using IndexPair = std::pair<size_t, size_t>;
 .def(py::self * float())                                \
 .def(py::self / float())                                \
 .def("__getitem__", [](const M& m, IndexPair i)         \
-    { return m[i.first][i.second]; } )                  \
+    { return m[checkIndex(i.first, N)]                  \
+              [checkIndex(i.second, N)]; } )            \
 .def("__setitem__", [](M& m, IndexPair i, float f)      \
-    { m[i.first][i.second] = f; })                      \
+    { m[checkIndex(i.first, N)]                         \
+       [checkIndex(i.second, N)] = f; })                \
 .def("__str__", [](const M& m)                          \
     { return mx::toValueString(m); })                   \
 .def("copy", [](const M& m) { return M(m); })           \
@@ -121,5 +138,8 @@ void bindPyTypes(py::module& mod)
         .def_static("createRotationX", &mx::Matrix44::createRotationX)
         .def_static("createRotationY", &mx::Matrix44::createRotationY)
         .def_static("createRotationZ", &mx::Matrix44::createRotationZ)
+        .def("transformPoint", &mx::Matrix44::transformPoint)
+        .def("transformVector", &mx::Matrix44::transformVector)
+        .def("transformNormal", &mx::Matrix44::transformNormal)
         .def_readonly_static("IDENTITY", &mx::Matrix44::IDENTITY);
 }